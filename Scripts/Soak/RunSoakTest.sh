@@ -0,0 +1,82 @@
+#!/usr/bin/env bash
+# Runs a local soak test - headless dedicated server plus N headless bot clients over loopback
+# with simulated latency and packet loss, then merges their reports (see UDodgerSoakRecorder).
+#
+#   Scripts/Soak/RunSoakTest.sh -c 8 -d 300 -l 60 -p 2 -m /Game/ThirdPerson/Maps/ThirdPersonMap
+set -euo pipefail
+
+PROJECT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+BINARIES_DIR="$PROJECT_DIR/Binaries/Linux"
+CLIENTS=4
+DURATION=120
+WARMUP=10
+LAG_MS=50
+LOSS_PERCENT=1
+MAP="/Game/ThirdPerson/Maps/ThirdPersonMap"
+PORT=7777
+REPORT_DIR="$PROJECT_DIR/Saved/Profiling/Soak/$(date +%Y.%m.%d-%H.%M.%S)"
+
+usage()
+{
+	echo "Usage: $0 [-c clients] [-d duration] [-w warmup] [-l lag ms] [-p loss percent] [-m map] [-b binaries dir] [-o report dir]"
+	exit 1
+}
+
+while getopts "c:d:w:l:p:m:b:o:h" Option; do
+	case "$Option" in
+		c) CLIENTS="$OPTARG" ;;
+		d) DURATION="$OPTARG" ;;
+		w) WARMUP="$OPTARG" ;;
+		l) LAG_MS="$OPTARG" ;;
+		p) LOSS_PERCENT="$OPTARG" ;;
+		m) MAP="$OPTARG" ;;
+		b) BINARIES_DIR="$OPTARG" ;;
+		o) REPORT_DIR="$OPTARG" ;;
+		*) usage ;;
+	esac
+done
+
+mkdir -p "$REPORT_DIR"
+
+# Both sides delay and drop their outgoing packets, so lag is split to keep round trip at LAG_MS
+NET_EMULATION="-PktLag=$((LAG_MS / 2)) -PktLoss=$LOSS_PERCENT"
+COMMON_ARGS="-nullrhi -nosound -unattended -log -DodgerSoak -SoakReportDir=$REPORT_DIR $NET_EMULATION"
+
+# Server measures while clients are connected - it starts first and stops after the last client joined,
+# LOAD_TIME covers connecting and loading the map so the last client finishes before the server does
+LOAD_TIME=15
+CLIENT_JOIN_TIME=$((CLIENTS * 2 + 5 + LOAD_TIME))
+
+# Hung processes (e.g. a client that lost the server) are killed instead of blocking the wait below
+PROCESS_SLACK=120
+SERVER_TIMEOUT=$((WARMUP + CLIENT_JOIN_TIME + DURATION + PROCESS_SLACK))
+CLIENT_TIMEOUT=$((WARMUP + LOAD_TIME + DURATION + PROCESS_SLACK))
+
+PIDS=()
+trap 'kill "${PIDS[@]}" 2>/dev/null || true' INT TERM
+
+echo "Starting server on $MAP, report in $REPORT_DIR"
+timeout -k 30 "$SERVER_TIMEOUT" "$BINARIES_DIR/DodgerServer" "$MAP" -port=$PORT $COMMON_ARGS \
+	-SoakWarmup=$((WARMUP + CLIENT_JOIN_TIME)) -SoakDuration="$DURATION" \
+	> "$REPORT_DIR/Server.log" 2>&1 &
+PIDS+=($!)
+
+sleep 5
+
+for Index in $(seq 1 "$CLIENTS"); do
+	echo "Starting bot client $Index"
+	timeout -k 30 "$CLIENT_TIMEOUT" "$BINARIES_DIR/Dodger" "127.0.0.1:$PORT" $COMMON_ARGS -DodgerBot \
+		-SoakWarmup="$WARMUP" -SoakDuration="$DURATION" \
+		> "$REPORT_DIR/Client$Index.log" 2>&1 &
+	PIDS+=($!)
+	sleep 2
+done
+
+# Every process exits on its own after writing its report, clients also when they lose the server
+STATUS=0
+for Pid in "${PIDS[@]}"; do
+	wait "$Pid" || STATUS=1
+done
+
+python3 "$PROJECT_DIR/Scripts/Soak/merge_soak_reports.py" "$REPORT_DIR"
+exit $STATUS
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Merges per process soak reports (see UDodgerSoakRecorder) into one report.
+
+Usage: merge_soak_reports.py <report dir>
+
+Writes SoakReport.json and SoakReport.txt into the report directory and prints the text report.
+"""
+
+import glob
+import json
+import os
+import sys
+
+
+def load_reports(report_dir):
+    reports = []
+    for path in sorted(glob.glob(os.path.join(report_dir, "*.json"))):
+        if os.path.basename(path) == "SoakReport.json":
+            continue
+        with open(path, encoding="utf-8") as file:
+            reports.append(json.load(file))
+    return reports
+
+
+def format_summary(name, summary, unit):
+    if not summary or not summary.get("Count"):
+        return f"  {name:<20} no samples"
+    return (f"  {name:<20} avg {summary['Avg']:9.2f}  p50 {summary['P50']:9.2f}  p95 {summary['P95']:9.2f}"
+            f"  p99 {summary['P99']:9.2f}  max {summary['Max']:9.2f} {unit}")
+
+
+def format_value(value, unit):
+    return f"{value:.2f} {unit}" if value is not None else "n/a"
+
+
+def format_incomplete(report):
+    if report.get("Completed", True):
+        return ""
+    return f" - incomplete: {report.get('Failure', 'unknown')}"
+
+
+def merge(reports):
+    servers = [report for report in reports if report["Role"] == "Server"]
+    clients = [report for report in reports if report["Role"] == "Client"]
+
+    accepted = sum(report.get("HitValidation", {}).get("Accepted", 0) for report in servers)
+    rejected = sum(report.get("HitValidation", {}).get("Rejected", 0) for report in servers)
+    verified = accepted + rejected
+
+    def worst(metric, key):
+        values = [report[metric][key] for report in clients if report[metric]["Count"]]
+        return max(values) if values else None
+
+    def mean(metric, key):
+        values = [report[metric][key] for report in clients if report[metric]["Count"]]
+        return sum(values) / len(values) if values else None
+
+    return {
+        "Server": servers[0] if servers else None,
+        "Clients": clients,
+        "HitValidation": {
+            "Accepted": accepted,
+            "Rejected": rejected,
+            "AcceptRate": accepted / verified if verified else None,
+        },
+        "ClientFrameTimeMs": {
+            "NumClients": len(clients),
+            "MeanP50": mean("FrameTimeMs", "P50"),
+            "WorstP95": worst("FrameTimeMs", "P95"),
+            "WorstP99": worst("FrameTimeMs", "P99"),
+            "WorstMax": worst("FrameTimeMs", "Max"),
+        },
+        "ClientBandwidth": {
+            "MeanInBytesPerSecond": mean("InBytesPerSecond", "Avg"),
+            "MeanOutBytesPerSecond": mean("OutBytesPerSecond", "Avg"),
+        },
+    }
+
+
+def format_report(merged):
+    lines = ["Dodger soak report", ""]
+
+    server = merged["Server"]
+    if server:
+        lines.append(f"Server ({server['Map']}, {server['MaxConnections']} connections, {server['Duration']:.0f} s){format_incomplete(server)}")
+        lines.append(format_summary("Tick time", server["FrameTimeMs"], "ms"))
+        lines.append(format_summary("Game thread time", server["GameThreadTimeMs"], "ms"))
+        lines.append(format_summary("Bandwidth in", server["InBytesPerSecond"], "B/s"))
+        lines.append(format_summary("Bandwidth out", server["OutBytesPerSecond"], "B/s"))
+        lines.append(format_summary("Out packet loss", server["OutLossPercent"], "%"))
+    else:
+        lines.append("Server report missing")
+    lines.append("")
+
+    hits = merged["HitValidation"]
+    rate = hits["AcceptRate"]
+    rate_text = f"{rate * 100.0:.1f}%" if rate is not None else "n/a"
+    lines.append(f"Hit validation: {hits['Accepted']} accepted, {hits['Rejected']} rejected, accept rate {rate_text}")
+    lines.append("")
+
+    for index, client in enumerate(merged["Clients"], 1):
+        lines.append(f"Client {index} (pid {client['ProcessId']}){format_incomplete(client)}")
+        lines.append(format_summary("Frame time", client["FrameTimeMs"], "ms"))
+        lines.append(format_summary("Bandwidth in", client["InBytesPerSecond"], "B/s"))
+        lines.append(format_summary("Bandwidth out", client["OutBytesPerSecond"], "B/s"))
+    if not merged["Clients"]:
+        lines.append("No client reports")
+
+    frame = merged["ClientFrameTimeMs"]
+    if frame["NumClients"]:
+        lines.append("")
+        lines.append(f"Clients: mean p50 {format_value(frame['MeanP50'], 'ms')}, worst p95 {format_value(frame['WorstP95'], 'ms')}, "
+                     f"worst p99 {format_value(frame['WorstP99'], 'ms')}, worst max {format_value(frame['WorstMax'], 'ms')}")
+
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        return 1
+
+    report_dir = sys.argv[1]
+    reports = load_reports(report_dir)
+    if not reports:
+        print(f"No reports found in {report_dir}")
+        return 1
+
+    merged = merge(reports)
+    text = format_report(merged)
+
+    with open(os.path.join(report_dir, "SoakReport.json"), "w", encoding="utf-8") as file:
+        json.dump(merged, file, indent=2)
+    with open(os.path.join(report_dir, "SoakReport.txt"), "w", encoding="utf-8") as file:
+        file.write(text)
+
+    print(text, end="")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,27 @@
+
+#include "CombatActionTimeline.h"
+
+#include "Animation/AnimMontage.h"
+
+bool FCombatActionTimeline::TryStart(float StartTime, float Duration, float BlendOutTime)
+{
+	if (StartTime < NextStartTime - Tolerance)
+	{
+		return false;
+	}
+
+	// Next window follows the expected start, not the early one - repeated early starts must not drift the cadence
+	NextStartTime = FMath::Max(StartTime, NextStartTime) + FMath::Max(Duration - BlendOutTime, 0.0f);
+	return true;
+}
+
+float FCombatActionTimeline::GetBlendOutTriggerTime(const UAnimMontage* Montage)
+{
+	if (!Montage)
+	{
+		return 0.0f;
+	}
+
+	// Negative trigger time means blend out starts its blend time before the end
+	return Montage->BlendOutTriggerTime >= 0.0f ? Montage->BlendOutTriggerTime : Montage->BlendOut.GetBlendTime();
+}
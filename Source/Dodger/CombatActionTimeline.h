@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAnimMontage;
+
+/**
+ * Spacing of one kind of montage driven action (attack, dodge) on the server timeline.
+ *
+ * Owning client chains held actions when the montage starts blending out, so the next action
+ * is accepted from the blend out trigger of the previous one rather than from its full length.
+ */
+class DODGER_API FCombatActionTimeline
+{
+public:
+	// Accepted early start of the next action, covers client clock estimate error
+	static constexpr float Tolerance = 0.05f;
+
+	/**
+	 * Accept action starting at StartTime (server time) if the previous one is blending out.
+	 * @param Duration		Real time length of the action (montage length / play rate)
+	 * @param BlendOutTime	Real time before the end when the next action may chain
+	 * @return true if accepted
+	 */
+	bool TryStart(float StartTime, float Duration, float BlendOutTime);
+
+	void Reset() { NextStartTime = -UE_BIG_NUMBER; }
+
+	/**
+	 * Real time before the end of montage its blend out starts (when held intents chain).
+	 */
+	static float GetBlendOutTriggerTime(const UAnimMontage* Montage);
+
+private:
+	// Server time from which the next action chains
+	float NextStartTime = -UE_BIG_NUMBER;
+};
@@ -2,14 +2,25 @@
 #include "DodgerCombatComponent.h"
 
 #include "Camera/CameraComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "Dodger/DodgerCharacter.h"
+#include "Dodger/DodgerDormancyManager.h"
+#include "Dodger/DodgerNetAccounting.h"
+#include "Dodger/DodgerPlayerController.h"
+#include "Dodger/DodgerStats.h"
+#include "Dodger/DodgerStressTimings.h"
 #include "Dodger/EnemyAIController.h"
 #include "Dodger/HitValidationTypes.h"
+#include "Dodger/MontageNotifyUtils.h"
+#include "Dodger/Components/HitValidationComponent.h"
 #include "Dodger/Projectile.h"
 #include "Dodger/ProjectileManager.h"
 #include "Dodger/Data/CombatConfig.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameStateBase.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "UObject/UObjectIterator.h"
 
 DEFINE_LOG_CATEGORY_STATIC(CombatLog, Log, All);
 
@@ -17,11 +28,33 @@ namespace
 {
 	constexpr TCHAR Label_SpawnProjectile[] = TEXT("SpawnProjectile");
 	constexpr TCHAR Label_Invulnerable[] = TEXT("Invulnerable");
+
+	void OnCombatDebugDrawChanged(IConsoleVariable* Variable);
+
+	TAutoConsoleVariable<bool> CVarCombatDebugDraw(
+		TEXT("Dodger.Combat.DebugDraw"),
+		false,
+		TEXT("Draw health, combat state and invulnerability above characters."),
+		FConsoleVariableDelegate::CreateStatic(&OnCombatDebugDrawChanged));
+
+	void OnCombatDebugDrawChanged(IConsoleVariable* Variable)
+	{
+		// Components tick only for the debug view, switch live ones right away
+		for (TObjectIterator<UDodgerCombatComponent> It; It; ++It)
+		{
+			if (It->IsRegistered() && It->HasBegunPlay())
+			{
+				It->RefreshTickEnabled();
+			}
+		}
+	}
 }
 
 UDodgerCombatComponent::UDodgerCombatComponent()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// Ticks only while there is per frame work to do (see RefreshTickEnabled)
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	SetIsReplicatedByDefault(true);
 
 	if (!Config)
@@ -58,23 +91,61 @@ void UDodgerCombatComponent::BeginPlay()
 	AnimInstance->OnPlayMontageNotifyBegin.AddDynamic(this, &ThisClass::OnMontageNotifyBegin);
 	AnimInstance->OnPlayMontageNotifyEnd.AddDynamic(this, &ThisClass::OnMontageNotifyEnd);
 	AnimInstance->OnMontageStarted.AddDynamic(this, &ThisClass::OnMontageStart);
-	AnimInstance->OnMontageEnded.AddDynamic(this, &ThisClass::OnMontageEnd);
+	AnimInstance->OnMontageBlendingOut.AddDynamic(this, &ThisClass::OnMontageBlendingOut);
+
+	OwningCharacter->LandedDelegate.AddDynamic(this, &ThisClass::OnLanded);
+
+	// Server times invulnerability and projectile spawns itself, cache notify times of the montages
+	if (!IsNetMode(NM_Client))
+	{
+		float NotifyEnd;
+		if (Config->AttackMontage && !MontageNotifyUtils::FindNotify(Config->AttackMontage, Label_SpawnProjectile, AttackSpawnNotifyTime, NotifyEnd))
+		{
+			UE_LOG(CombatLog, Warning, TEXT("[%hs] Attack montage %s has no '%s' notify."), __func__, *GetNameSafe(Config->AttackMontage), Label_SpawnProjectile);
+		}
+
+		bHasDodgeInvulnerability = MontageNotifyUtils::FindNotify(Config->DodgeMontage, Label_Invulnerable, DodgeInvulnerableStart, DodgeInvulnerableEnd);
+		if (Config->DodgeMontage && !bHasDodgeInvulnerability)
+		{
+			UE_LOG(CombatLog, Warning, TEXT("[%hs] Dodge montage %s has no '%s' notify window."), __func__, *GetNameSafe(Config->DodgeMontage), Label_Invulnerable);
+		}
+	}
 
 	// Initialize late joining clients with current state
 	if (GetWorld()->IsNetMode(NM_Client))
 	{
 		InitLateJoiners();
 	}
+	else
+	{
+		RefreshRepState();
+	}
+
+	RefreshTickEnabled();
 }
 
 void UDodgerCombatComponent::InitLateJoiners()
 {
-	// If there's an active montage, resume it at the correct position
+	// Local state follows montage events from here on
+	CombatState = RepState.State;
+	bIsInvulnerable = RepState.bInvulnerable;
+
+	// If there's an active montage, resume it at the position it has on server now
 	if (UAnimMontage* CurrentMontage = StateToMontage(CombatState))
 	{
-		const float PlayRate = CombatState == ECombatState::Attack ? Config->AttackRate : Config->DodgeRate;
-		UAnimInstance* AnimInstance = OwningCharacter->GetMesh()->GetAnimInstance();
-		AnimInstance->Montage_Play(CurrentMontage, PlayRate, EMontagePlayReturnType::MontageLength, MontagePlaybackPosition);
+		// Montage_Play scales by the montage's own RateScale as well, as does the server timeline
+		const float PlayRate = StateToPlayRate(CombatState);
+		const float Position = (GetServerWorldTime() - RepState.GetMontageStartTime()) * PlayRate * CurrentMontage->RateScale;
+		if (Position >= 0.0f && Position < CurrentMontage->GetPlayLength())
+		{
+			UAnimInstance* AnimInstance = OwningCharacter->GetMesh()->GetAnimInstance();
+			AnimInstance->Montage_Play(CurrentMontage, PlayRate, EMontagePlayReturnType::MontageLength, Position);
+		}
+		else
+		{
+			// Montage already finished on server while we were joining
+			SetCombatState(ECombatState::Idle);
+		}
 	}
 	// Handle dead state for late joiners
 	else if (CombatState == ECombatState::Dead)
@@ -86,41 +157,88 @@ void UDodgerCombatComponent::InitLateJoiners()
 
 void UDodgerCombatComponent::SetFireIntent(bool bActive)
 {
+	const bool bChanged = bFireIntent != bActive;
 	bFireIntent = bActive;
+
+	if (bChanged && bActive)
+	{
+		UpdateCombat();
+	}
 }
 
 void UDodgerCombatComponent::SetDodgeIntent(bool bActive)
 {
+	const bool bChanged = bDodgeIntent != bActive;
 	bDodgeIntent = bActive;
+
+	if (bChanged && bActive)
+	{
+		UpdateCombat();
+	}
 }
 
 void UDodgerCombatComponent::FireProjectile()
 {
-	// Only handle locally controlled characters to have correct Aim settings
-	if (OwningCharacter->IsLocallyControlled())
+	// Server spawns remote clients' projectiles at the time derived from their attack command
+	if (!OwningCharacter->IsLocallyControlled() && !IsNetMode(NM_Client))
 	{
-		// Calculate aim points
-		FVector AimOrigin, AimTarget;
-		EvaluateAimOriginAndTarget(AimOrigin, AimTarget);
+		return;
+	}
 
-		// Spawn projectile locally
-		HandleSpawnProjectile(AimOrigin, AimTarget);
+	// Owner and simulated proxies spawn locally with aim received at attack start
+	HandleSpawnProjectile(ComputeAimOrigin(), AttackAim.GetDirection());
+}
 
-		// Notify simulated proxy to spawn locally
-		if (OwningCharacter->HasAuthority())
-		{
-			NetMultiFireProjectile(AimOrigin, AimTarget);
-		}
-		else
-		{
-			ServerFireProjectile(AimOrigin, AimTarget);
-		}
+void UDodgerCombatComponent::SpawnServerProjectile(FDodgerQuantizedAim Aim)
+{
+	if (CombatState != ECombatState::Dead)
+	{
+		HandleSpawnProjectile(ComputeAimOrigin(), Aim.GetDirection());
 	}
 }
 
-void UDodgerCombatComponent::ServerDodge_Implementation(const FVector_NetQuantizeNormal& Direction)
+void UDodgerCombatComponent::ServerDodge_Implementation(const FVector_NetQuantizeNormal& Direction, float ClientTimestamp)
 {
-	NetMultiDodge(Direction);
+	if (CombatState == ECombatState::Dead)
+	{
+		return;
+	}
+
+	// Client dodged at its estimate of server time - trust it within the prediction limit
+	const float ServerTime = GetWorld()->GetTimeSeconds();
+	const float StartTime = FMath::Clamp(ClientTimestamp, ServerTime - Config->MaxPredictionTime, ServerTime);
+
+	if (RecordServerDodge(StartTime))
+	{
+		NetMultiDodge(Direction);
+	}
+}
+
+bool UDodgerCombatComponent::RecordServerDodge(float StartTime)
+{
+	if (!Config->DodgeMontage)
+	{
+		return false;
+	}
+
+	// Validate on the server timeline, server montage may still be playing because of latency
+	const float Rate = FMath::Max(Config->DodgeRate * Config->DodgeMontage->RateScale, UE_KINDA_SMALL_NUMBER);
+	const float BlendOutTime = FCombatActionTimeline::GetBlendOutTriggerTime(Config->DodgeMontage);
+	if (!DodgeTimeline.TryStart(StartTime, Config->DodgeMontage->GetPlayLength() / Rate, BlendOutTime))
+	{
+		UE_LOG(CombatLog, Verbose, TEXT("[%hs] Rejected dodge of %s, previous one still active."), __func__, *GetNameSafe(GetOwner()));
+		return false;
+	}
+
+	// Dodge cancels the attack, its projectile must not appear on server
+	GetWorld()->GetTimerManager().ClearTimer(ServerProjectileTimer);
+
+	if (bHasDodgeInvulnerability)
+	{
+		OwningCharacter->GetHitValidation()->RecordInvulnerabilityWindow(StartTime + DodgeInvulnerableStart / Rate, StartTime + DodgeInvulnerableEnd / Rate);
+	}
+
+	return true;
 }
 
 void UDodgerCombatComponent::NetMultiDodge_Implementation(const FVector_NetQuantizeNormal& Direction)
@@ -136,12 +254,49 @@ void UDodgerCombatComponent::NetMultiDodge_Implementation(const FVector_NetQuant
 	OwningCharacter->PlayAnimMontage(Config->DodgeMontage, Config->DodgeRate);
 }
 
-void UDodgerCombatComponent::ServerAttack_Implementation()
+void UDodgerCombatComponent::ServerAttackCommand_Implementation(const FDodgerAttackCommand& Command)
 {
-	NetMultiAttack();
+	if (CombatState == ECombatState::Dead || !Config->AttackMontage)
+	{
+		return;
+	}
+
+	// Duplicated or reordered command
+	if (!FDodgerAttackCommand::IsSequenceNewer(Command.Sequence, AttackSequence))
+	{
+		return;
+	}
+	AttackSequence = Command.Sequence;
+
+	// Client attacked at its estimate of server time - trust it within the prediction limit
+	const float ServerTime = GetWorld()->GetTimeSeconds();
+	const float StartTime = FMath::Clamp(Command.ClientTimestamp, ServerTime - Config->MaxPredictionTime, ServerTime);
+
+	// Attacks can't overlap - reject faster fire than the montage allows, held fire chains at blend out
+	const float Rate = FMath::Max(Config->AttackRate * Config->AttackMontage->RateScale, UE_KINDA_SMALL_NUMBER);
+	const float BlendOutTime = FCombatActionTimeline::GetBlendOutTriggerTime(Config->AttackMontage);
+	if (!AttackTimeline.TryStart(StartTime, Config->AttackMontage->GetPlayLength() / Rate, BlendOutTime))
+	{
+		UE_LOG(CombatLog, Verbose, TEXT("[%hs] Rejected attack %d of %s, previous one still active."), __func__, Command.Sequence, *GetNameSafe(GetOwner()));
+		return;
+	}
+
+	// Spawn server copy of the projectile when the notify fires on the client timeline
+	const float SpawnDelay = StartTime + AttackSpawnNotifyTime / Rate - ServerTime;
+	if (SpawnDelay > 0.0f)
+	{
+		const FTimerDelegate SpawnDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::SpawnServerProjectile, Command.Aim);
+		GetWorld()->GetTimerManager().SetTimer(ServerProjectileTimer, SpawnDelegate, SpawnDelay, false);
+	}
+	else
+	{
+		SpawnServerProjectile(Command.Aim);
+	}
+
+	NetMultiAttack(Command.Aim);
 }
 
-void UDodgerCombatComponent::NetMultiAttack_Implementation()
+void UDodgerCombatComponent::NetMultiAttack_Implementation(const FDodgerQuantizedAim& Aim)
 {
 	// Skip if locally controlled (already handled)
 	if (!OwningCharacter.IsValid() || OwningCharacter->IsLocallyControlled())
@@ -149,46 +304,47 @@ void UDodgerCombatComponent::NetMultiAttack_Implementation()
 		return;
 	}
 	
-	// Play attack animation on simulated proxies
+	// Play attack animation on simulated proxies, projectile follows at the notify
+	AttackAim = Aim;
 	OwningCharacter->PlayAnimMontage(Config->AttackMontage, Config->AttackRate);
 }
 
-void UDodgerCombatComponent::UpdateCombat(float DeltaTime)
+void UDodgerCombatComponent::UpdateCombat()
 {
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerUpdateCombat);
+	DODGER_STRESS_TIMING_SCOPE("Combat");
+	DODGER_INC_COUNTER(STAT_DodgerCombatUpdates, 1);
+
 	// Only process if character isn't dead
-	if (CombatState != ECombatState::Dead)
+	if (CombatState == ECombatState::Dead || !OwningCharacter.IsValid())
 	{
-		// Character wants to dodge
-		if (bDodgeIntent)
-		{
-			if (CanDodge())
-			{
-				PerformDodge();
-			}
-		}
-		// Character wants to fire - handled in second priority (attack can be interrupted)
-		else if (bFireIntent)
+		return;
+	}
+	
+	// Character wants to dodge
+	if (bDodgeIntent)
+	{
+		if (CanDodge())
 		{
-			if (CanAttack())
-			{
-				PerformAttack();
-			}
+			PerformDodge();
 		}
 	}
-
-	// Track current montage position for late joiners purposes
-	if (!IsNetMode(NM_Client))
+	// Character wants to fire - handled in second priority (attack can be interrupted)
+	else if (bFireIntent)
 	{
-		// replicate current montage position for late joiners
-		if (UAnimMontage* CurrentMontage = StateToMontage(CombatState))
+		if (CanAttack())
 		{
-			UAnimInstance* AnimInstance = OwningCharacter->GetMesh()->GetAnimInstance();
-			MontagePlaybackPosition = AnimInstance->Montage_GetPosition(CurrentMontage);
+			PerformAttack();
 		}
 	}
+}
+
+void UDodgerCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// draw debug info
-	if (!IsNetMode(NM_DedicatedServer))
+	if (CVarCombatDebugDraw.GetValueOnGameThread() && !IsNetMode(NM_DedicatedServer))
 	{
 		static const TMap<ECombatState, FString> StateToStringMap = {
 			{ECombatState::Idle, TEXT("Idle")},
@@ -203,20 +359,99 @@ void UDodgerCombatComponent::UpdateCombat(float DeltaTime)
 	}
 }
 
+void UDodgerCombatComponent::SetCombatState(ECombatState NewState)
+{
+	if (CombatState != NewState)
+	{
+		WakeOwnerFromDormancy();
+		CombatState = NewState;
+		RefreshTickEnabled();
+		RefreshRepState();
+	}
+}
+
+void UDodgerCombatComponent::RefreshRepState()
+{
+	if (GetOwnerRole() != ROLE_Authority || !OwningCharacter.IsValid())
+	{
+		return;
+	}
+
+	FDodgerCombatRepState NewRepState = RepState;
+	NewRepState.SetHealth(OwningCharacter->GetHealth());
+	NewRepState.State = CombatState;
+	NewRepState.bInvulnerable = bIsInvulnerable;
+	NewRepState.SetMontageStartTime(MontageStartTime);
+
+	if (NewRepState != RepState)
+	{
+		RepState = NewRepState;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UDodgerCombatComponent, RepState, this);
+	}
+}
+
+void UDodgerCombatComponent::ScheduleCombatUpdate()
+{
+	// Deferred to next tick - acting from inside montage callbacks would re-enter the anim instance
+	if (!bCombatUpdateScheduled)
+	{
+		bCombatUpdateScheduled = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::OnScheduledCombatUpdate);
+	}
+}
+
+void UDodgerCombatComponent::OnScheduledCombatUpdate()
+{
+	bCombatUpdateScheduled = false;
+
+	if (!OwningCharacter.IsValid())
+	{
+		return;
+	}
+
+	// Montage was interrupted without another one taking over - fall back to idle
+	if (UAnimMontage* StateMontage = StateToMontage(CombatState))
+	{
+		const UAnimInstance* AnimInstance = OwningCharacter->GetMesh()->GetAnimInstance();
+		if (!AnimInstance || !AnimInstance->Montage_IsPlaying(StateMontage))
+		{
+			SetCombatState(ECombatState::Idle);
+		}
+	}
+
+	UpdateCombat();
+}
+
+void UDodgerCombatComponent::RefreshTickEnabled()
+{
+	// Only debug view needs every frame
+	const bool bDrawDebug = CVarCombatDebugDraw.GetValueOnGameThread() && !IsNetMode(NM_DedicatedServer);
+	SetComponentTickEnabled(bDrawDebug);
+}
+
 void UDodgerCombatComponent::PerformAttack()
 {
 	// Play animation locally
 	if (OwningCharacter->IsLocallyControlled())
 	{
+		// Lock aim for the whole attack - the same quantized direction is used on every machine
+		FVector AimOrigin, AimTarget;
+		EvaluateAimOriginAndTarget(AimOrigin, AimTarget);
+		AttackAim.SetDirection(AimTarget - AimOrigin);
+
 		OwningCharacter->PlayAnimMontage(Config->AttackMontage, Config->AttackRate);
 		
 		if (OwningCharacter->HasAuthority())
 		{
-			NetMultiAttack();
+			NetMultiAttack(AttackAim);
 		}
 		else
 		{
-			ServerAttack();
+			FDodgerAttackCommand Command;
+			Command.Sequence = ++AttackSequence;
+			Command.ClientTimestamp = GetServerWorldTime();
+			Command.Aim = AttackAim;
+			ServerAttackCommand(Command);
 		}
 	}
 }
@@ -226,12 +461,6 @@ bool UDodgerCombatComponent::CanAttack() const
 	return Config->AttackMontage && !IsAttacking() && !IsDodging();
 }
 
-bool UDodgerCombatComponent::IsAttacking() const
-{
-	const UAnimInstance* AnimInstance = OwningCharacter->GetMesh()->GetAnimInstance();
-	return AnimInstance && AnimInstance->Montage_IsPlaying(Config->AttackMontage);
-}
-
 void UDodgerCombatComponent::PerformDodge()
 {
 	if (OwningCharacter->IsLocallyControlled())
@@ -246,16 +475,17 @@ void UDodgerCombatComponent::PerformDodge()
 
 		OwningCharacter->SetActorRotation(Direction.ToOrientationQuat());
 		
-		// Play dodge animation
+		// Play dodge animation - predicted, server validates with the timestamp
 		OwningCharacter->PlayAnimMontage(Config->DodgeMontage, Config->DodgeRate);
 		
 		if (OwningCharacter->HasAuthority())
 		{
+			RecordServerDodge(GetWorld()->GetTimeSeconds());
 			NetMultiDodge(Direction);
 		}
 		else
 		{
-			ServerDodge(Direction);
+			ServerDodge(Direction, GetServerWorldTime());
 		}
 	}
 }
@@ -265,38 +495,54 @@ bool UDodgerCombatComponent::CanDodge() const
 	return Config->DodgeMontage && !IsDodging() && !OwningCharacter->GetCharacterMovement()->IsFalling();
 }
 
-bool UDodgerCombatComponent::IsDodging() const
+void UDodgerCombatComponent::NetMultiServeFinalBlow_Implementation(const FVector_NetQuantizeNormal& Direction)
 {
-	const UAnimInstance* AnimInstance = OwningCharacter->GetMesh()->GetAnimInstance();
-	return AnimInstance && AnimInstance->Montage_IsPlaying(Config->DodgeMontage);
+	SetCombatState(ECombatState::Dead);
+	OwningCharacter->GetMesh()->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
+	OwningCharacter->GetMesh()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+	OwningCharacter->GetMesh()->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Ignore);
+	OwningCharacter->GetMesh()->SetCollisionResponseToChannel(ECC_HitBox, ECR_Ignore);
+	OwningCharacter->GetMesh()->SetSimulatePhysics(true);
+	constexpr float LaunchSize = 8000.0f;
+	OwningCharacter->GetMesh()->AddImpulse(Direction * LaunchSize, NAME_None, true);
 }
 
-void UDodgerCombatComponent::ServerFireProjectile_Implementation(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target)
+void UDodgerCombatComponent::NetMultiResetCombat_Implementation()
 {
-	NetMultiFireProjectile(Origin, Target);
+	USkeletalMeshComponent* Mesh = OwningCharacter->GetMesh();
+	if (Mesh->IsSimulatingPhysics())
+	{
+		// Ragdoll moved the mesh away from capsule - put it back where the character had it
+		Mesh->SetSimulatePhysics(false);
+		Mesh->AttachToComponent(OwningCharacter->GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		Mesh->SetRelativeLocationAndRotation(OwningCharacter->GetBaseTranslationOffset(), OwningCharacter->GetBaseRotationOffset());
+	}
+
+	const USkeletalMeshComponent* DefaultMesh = OwningCharacter->GetClass()->GetDefaultObject<ACharacter>()->GetMesh();
+	Mesh->SetCollisionEnabled(DefaultMesh->GetCollisionEnabled());
+	Mesh->SetCollisionResponseToChannels(DefaultMesh->GetCollisionResponseToChannels());
+
+	ResetCombat();
 }
 
-void UDodgerCombatComponent::NetMultiFireProjectile_Implementation(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target)
+void UDodgerCombatComponent::ResetCombat()
 {
-	// local player already handled - handle simulated proxy and server only
-	if (!OwningCharacter.IsValid() || OwningCharacter->IsLocallyControlled())
+	bFireIntent = false;
+	bDodgeIntent = false;
+	bIsInvulnerable = false;
+	DodgeTimeline.Reset();
+	AttackTimeline.Reset();
+	GetWorld()->GetTimerManager().ClearTimer(ServerProjectileTimer);
+
+	// Still Dead while montages stop, so blend out callbacks don't act on them
+	if (UAnimInstance* AnimInstance = OwningCharacter->GetMesh()->GetAnimInstance())
 	{
-		return;
+		AnimInstance->StopAllMontages(0.0f);
 	}
-	
-	HandleSpawnProjectile(Origin, Target);
-}
 
-void UDodgerCombatComponent::NetMultiServeFinalBlow_Implementation(const FVector_NetQuantizeNormal& Direction)
-{
-	CombatState = ECombatState::Dead;
-	OwningCharacter->GetMesh()->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
-	OwningCharacter->GetMesh()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
-	OwningCharacter->GetMesh()->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Ignore);
-	OwningCharacter->GetMesh()->SetCollisionResponseToChannel(ECC_HitBox, ECR_Ignore);
-	OwningCharacter->GetMesh()->SetSimulatePhysics(true);
-	constexpr float LaunchSize = 8000.0f;
-	OwningCharacter->GetMesh()->AddImpulse(Direction * LaunchSize, NAME_None, true);
+	SetCombatState(ECombatState::Idle);
+	MontageStartTime = 0.0f;
+	RefreshRepState();
 }
 
 void UDodgerCombatComponent::OnMontageStart(UAnimMontage* Montage)
@@ -304,11 +550,18 @@ void UDodgerCombatComponent::OnMontageStart(UAnimMontage* Montage)
 	if (CombatState != ECombatState::Dead)
 	{
 		// Update combat state based on montage
-		CombatState = MontageToState(Montage);
+		SetCombatState(MontageToState(Montage));
+
+		// Timestamp montage start for late joiners
+		if (!IsNetMode(NM_Client) && StateToMontage(CombatState))
+		{
+			MontageStartTime = GetWorld()->GetTimeSeconds();
+			RefreshRepState();
+		}
 	}
 }
 
-void UDodgerCombatComponent::OnMontageEnd(UAnimMontage* Montage, bool bInterrupted)
+void UDodgerCombatComponent::OnMontageBlendingOut(UAnimMontage* Montage, bool bInterrupted)
 {
 	if (CombatState != ECombatState::Dead)
 	{
@@ -316,8 +569,11 @@ void UDodgerCombatComponent::OnMontageEnd(UAnimMontage* Montage, bool bInterrupt
 		if (!bInterrupted)
 		{
 			// ended animation without interruption - nothing happens - idle
-			CombatState = ECombatState::Idle;
+			SetCombatState(ECombatState::Idle);
 		}
+
+		// Held intents continue (auto fire, chained dodges), interrupted state is validated
+		ScheduleCombatUpdate();
 	}
 }
 
@@ -332,6 +588,7 @@ void UDodgerCombatComponent::OnMontageNotifyBegin(FName NotifyName, const FBranc
 	else if (NotifyName == Label_Invulnerable)
 	{
 		bIsInvulnerable = true;
+		RefreshRepState();
 	}
 }
 
@@ -341,6 +598,16 @@ void UDodgerCombatComponent::OnMontageNotifyEnd(FName NotifyName, const FBranchi
 	if (NotifyName == Label_Invulnerable)
 	{
 		bIsInvulnerable = false;
+		RefreshRepState();
+	}
+}
+
+void UDodgerCombatComponent::OnLanded(const FHitResult& Hit)
+{
+	// Dodge requested mid-air can be performed now
+	if (bDodgeIntent)
+	{
+		UpdateCombat();
 	}
 }
 
@@ -361,6 +628,11 @@ FVector UDodgerCombatComponent::ComputeDodgeDirection() const
 	}
 }
 
+FVector UDodgerCombatComponent::ComputeAimOrigin() const
+{
+	return OwningCharacter->GetPawnViewLocation() + OwningCharacter->GetActorForwardVector() * Config->AimOffset;
+}
+
 void UDodgerCombatComponent::EvaluateAimOriginAndTarget(FVector& AimOrigin, FVector& AimTarget) const
 {
 	// Only handle locally controlled characters
@@ -370,12 +642,14 @@ void UDodgerCombatComponent::EvaluateAimOriginAndTarget(FVector& AimOrigin, FVec
 	}
 
 	// Calculate base aim origin (where projectile starts)
-	AimOrigin = OwningCharacter->GetPawnViewLocation() + OwningCharacter->GetActorForwardVector() * Config->AimOffset;
+	AimOrigin = ComputeAimOrigin();
 
-	// AI-specific targeting
-	if (AEnemyAIController* EnemyAI = Cast<AEnemyAIController>(OwningCharacter->GetController()))
+	// AI-specific targeting - enemies aim at their target, other AI (e.g. bots) at their focus
+	if (const AAIController* AIController = Cast<AAIController>(OwningCharacter->GetController()))
 	{
-		AimTarget = EnemyAI->GetTargetActor() ? EnemyAI->GetTargetActor()->GetActorLocation() : AimOrigin + EnemyAI->GetPawn()->GetActorForwardVector() * Config->AimOffset;
+		const AEnemyAIController* EnemyAI = Cast<AEnemyAIController>(AIController);
+		const AActor* Target = EnemyAI ? EnemyAI->GetTargetActor() : AIController->GetFocusActor();
+		AimTarget = Target ? Target->GetActorLocation() : AimOrigin + OwningCharacter->GetActorForwardVector() * Config->AimOffset;
 		AimTarget += FMath::VRandCone(OwningCharacter->GetActorForwardVector(), 30.0f) * 60; 
 	}
 	else
@@ -394,10 +668,9 @@ void UDodgerCombatComponent::EvaluateAimOriginAndTarget(FVector& AimOrigin, FVec
 	}
 }
 
-void UDodgerCombatComponent::HandleSpawnProjectile(const FVector& AimOrigin, const FVector& AimTarget)
+void UDodgerCombatComponent::HandleSpawnProjectile(const FVector& AimOrigin, const FVector& AimDirection)
 {
-	FVector Dir = (AimTarget - AimOrigin).GetSafeNormal();
-	UProjectileManager::Get(this)->LaunchProjectile(Config->ProjectileClass, AimOrigin, Dir.Rotation(), Cast<APawn>(GetOwner()));
+	UProjectileManager::Get(this)->LaunchProjectile(Config->ProjectileClass, AimOrigin, AimDirection.Rotation(), Cast<APawn>(GetOwner()));
 }
 
 ECombatState UDodgerCombatComponent::MontageToState(UAnimMontage* Montage) const
@@ -418,11 +691,74 @@ UAnimMontage* UDodgerCombatComponent::StateToMontage(ECombatState State) const
 	}
 }
 
+float UDodgerCombatComponent::StateToPlayRate(ECombatState State) const
+{
+	switch (State)
+	{
+	case ECombatState::Attack: return Config->AttackRate;
+	case ECombatState::Dodge:  return Config->DodgeRate;
+	default: return 1.0f;
+	}
+}
+
+float UDodgerCombatComponent::GetServerWorldTime() const
+{
+	if (!IsNetMode(NM_Client))
+	{
+		return GetWorld()->GetTimeSeconds();
+	}
+
+	// Filtered clock of the local player
+	const ADodgerPlayerController* PlayerController = Cast<ADodgerPlayerController>(GetWorld()->GetFirstPlayerController());
+	if (PlayerController && PlayerController->IsServerTimeSynchronized())
+	{
+		return PlayerController->GetServerTime();
+	}
+
+	// Clock filter still converging (typical while joining) - replicated game state time is coarser but valid
+	if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+	{
+		return static_cast<float>(GameState->GetServerWorldTimeSeconds());
+	}
+
+	return GetWorld()->GetTimeSeconds();
+}
+
 void UDodgerCombatComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	// Only send initial state to clients for late joiners
-	DOREPLIFETIME_CONDITION(UDodgerCombatComponent, CombatState, COND_InitialOnly);
-	DOREPLIFETIME_CONDITION(UDodgerCombatComponent, MontagePlaybackPosition, COND_InitialOnly);
+	// Push model - only delta serialized after RefreshRepState changed it
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UDodgerCombatComponent, RepState, Params);
+}
+
+bool UDodgerCombatComponent::CallRemoteFunction(UFunction* Function, void* Parms, FOutParmRec* OutParms, FFrame* Stack)
+{
+	if (UDodgerNetAccounting* NetAccounting = UDodgerNetAccounting::Get(this))
+	{
+		NetAccounting->RecordRemoteFunction(GetOwner(), Function, Parms);
+	}
+
+	// Multicasts of dormant actors don't reach anyone
+	if (Function->HasAnyFunctionFlags(FUNC_NetMulticast))
+	{
+		WakeOwnerFromDormancy();
+	}
+
+	return Super::CallRemoteFunction(Function, Parms, OutParms, Stack);
+}
+
+void UDodgerCombatComponent::WakeOwnerFromDormancy() const
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	if (UDodgerDormancyManager* DormancyManager = UDodgerDormancyManager::Get(this))
+	{
+		DormancyManager->WakeCharacter(Cast<ADodgerCharacter>(GetOwner()));
+	}
 }
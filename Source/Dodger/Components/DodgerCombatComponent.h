@@ -3,6 +3,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Dodger/CombatActionTimeline.h"
+#include "Dodger/DodgerNetTypes.h"
 #include "DodgerCombatComponent.generated.h"
 
 class UBoxComponent;
@@ -10,15 +12,6 @@ class AProjectile;
 class ADodgerCharacter;
 class UCombatConfig;
 
-UENUM()
-enum class ECombatState : uint8
-{
-	Idle,
-	Attack,
-	Dodge,
-	Dead
-};
-
 UCLASS()
 class DODGER_API UDodgerCombatComponent : public UActorComponent
 {
@@ -36,18 +29,29 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void SetDodgeIntent(bool bActive);
 
-	// Getters for combat state and status
+	// Getters for combat state and status - cached, driven by montage events
 	ECombatState GetState() const { return CombatState; };
 	bool IsInvulnerable() const { return bIsInvulnerable; }
-	bool IsDodging() const;
-	bool IsAttacking() const;
+	bool IsDodging() const { return CombatState == ECombatState::Dodge; }
+	bool IsAttacking() const { return CombatState == ECombatState::Attack; }
+	float GetReplicatedHealth() const { return RepState.GetHealth(); }
+
+	// Copy current health, state, invulnerability and montage start to the replicated state (server only)
+	void RefreshRepState();
 	
-	// Main update function called every frame
-	void UpdateCombat(float DeltaTime);
+	// Try to act on current intents. Called on intent changes and combat events, never polled
+	void UpdateCombat();
+
+	// Enable tick only while there is per frame work - the debug view
+	void RefreshTickEnabled();
 	
 	// Handle final attack when character health drops to 0
 	UFUNCTION(NetMulticast, Reliable)
 	void NetMultiServeFinalBlow(const FVector_NetQuantizeNormal& Direction);
+
+	// Undo final blow and reset combat state of a reused (pooled) character
+	UFUNCTION(NetMulticast, Reliable)
+	void NetMultiResetCombat();
 protected:
 	// Initialize late joining players with current state
 	void InitLateJoiners();
@@ -55,33 +59,31 @@ protected:
 	// Base Interface
 	virtual void PostInitProperties() override;
 	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parms, FOutParmRec* OutParms, FFrame* Stack) override;
 	
 	// Fire Logic
 	void PerformAttack();
 	bool CanAttack() const;
 	void FireProjectile();
+	void SpawnServerProjectile(FDodgerQuantizedAim Aim);
 	
 	// Dodge Logic
 	void PerformDodge();
 	bool CanDodge() const;
+	bool RecordServerDodge(float StartTime);
 	
 private:
 	
-	// RPCs for attack montage
+	// RPCs for attack - montage and projectile, projectile spawns at the montage notify
 	UFUNCTION(Server, Reliable)
-	void ServerAttack();
+	void ServerAttackCommand(const FDodgerAttackCommand& Command);
 	UFUNCTION(NetMulticast, Unreliable)
-	void NetMultiAttack();
-
-	// RPCs for spawning projectile
-	UFUNCTION(Server, Reliable)
-	void ServerFireProjectile(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target);
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMultiFireProjectile(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target);
+	void NetMultiAttack(const FDodgerQuantizedAim& Aim);
 
 	// RPCs for dodge action
 	UFUNCTION(Server, Reliable)
-	void ServerDodge(const FVector_NetQuantizeNormal& Direction);
+	void ServerDodge(const FVector_NetQuantizeNormal& Direction, float ClientTimestamp);
 	UFUNCTION(NetMulticast, Unreliable)
 	void NetMultiDodge(const FVector_NetQuantizeNormal& Direction);
 	
@@ -89,18 +91,32 @@ private:
 	UFUNCTION()
 	void OnMontageStart(UAnimMontage* Montage);
 	UFUNCTION()
-	void OnMontageEnd(UAnimMontage* Montage, bool bInterrupted);
+	void OnMontageBlendingOut(UAnimMontage* Montage, bool bInterrupted);
 	UFUNCTION()
 	void OnMontageNotifyBegin(FName NotifyName, const FBranchingPointNotifyPayload& BranchingPointPayload);
 	UFUNCTION()
 	void OnMontageNotifyEnd(FName NotifyName, const FBranchingPointNotifyPayload& BranchingPointPayload);
+
+	// Movement notifier - dodge is blocked while falling
+	UFUNCTION()
+	void OnLanded(const FHitResult& Hit);
+
+	// State machine
+	void SetCombatState(ECombatState NewState);
+	void ResetCombat();
+	void ScheduleCombatUpdate();
+	void OnScheduledCombatUpdate();
 	
 	// Helpers
 	FVector ComputeDodgeDirection() const;
+	FVector ComputeAimOrigin() const;
 	void EvaluateAimOriginAndTarget(FVector& AimOrigin, FVector& AimTarget) const;
-	void HandleSpawnProjectile(const FVector& AimOrigin, const FVector& AimTarget);
+	void HandleSpawnProjectile(const FVector& AimOrigin, const FVector& AimDirection);
 	ECombatState MontageToState(UAnimMontage* Montage) const;
 	UAnimMontage* StateToMontage(ECombatState State) const;
+	float StateToPlayRate(ECombatState State) const;
+	float GetServerWorldTime() const;
+	void WakeOwnerFromDormancy() const;
 	
 	// Combat Config
 	UPROPERTY(EditAnywhere, Category = "Combat")
@@ -116,9 +132,35 @@ private:
 	// Invulnerability flag set during dodge action
 	bool bIsInvulnerable = false;
 
-	// Replicated properties for late joiners
-	UPROPERTY(Replicated)
+	// Combat update already queued for next tick
+	bool bCombatUpdateScheduled = false;
+
+	// Invulnerable part of the dodge montage (montage positions), read from notify window
+	float DodgeInvulnerableStart = 0.0f;
+	float DodgeInvulnerableEnd = 0.0f;
+	bool bHasDodgeInvulnerability = false;
+
+	// Accepted dodges on the server timeline
+	FCombatActionTimeline DodgeTimeline;
+
+	// Position of the projectile spawn notify in attack montage
+	float AttackSpawnNotifyTime = 0.0f;
+
+	// Aim of the current attack, locked when the attack starts
+	FDodgerQuantizedAim AttackAim;
+
+	// Attack commands - sent by owning client, last accepted on server
+	uint16 AttackSequence = 0;
+	FCombatActionTimeline AttackTimeline;
+
+	// Server copy of a remote client's projectile waiting for its spawn time
+	FTimerHandle ServerProjectileTimer;
+
 	ECombatState CombatState = ECombatState::Idle;
+	// Server time when current montage started - joiners derive montage position
+	float MontageStartTime = 0.0f;
+
+	// Server combat state for everyone - clients read health from it, late joiners also state and montage
 	UPROPERTY(Replicated)
-	float MontagePlaybackPosition = 0.0f;
+	FDodgerCombatRepState RepState;
 };
\ No newline at end of file
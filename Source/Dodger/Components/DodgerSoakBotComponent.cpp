@@ -0,0 +1,119 @@
+
+#include "DodgerSoakBotComponent.h"
+
+#include "EngineUtils.h"
+#include "Dodger/DodgerCharacter.h"
+#include "GameFramework/PlayerController.h"
+
+UDodgerSoakBotComponent::UDodgerSoakBotComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+bool UDodgerSoakBotComponent::IsRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("DodgerBot"));
+}
+
+void UDodgerSoakBotComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	ADodgerCharacter* Character = PlayerController ? Cast<ADodgerCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (Character != ControlledCharacter.Get())
+	{
+		ReleaseIntents();
+		ControlledCharacter = Character;
+	}
+
+	if (!Character || Character->GetHealth() <= 0.0f)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Wander in a random direction for a while, like a player strafing around
+	if (Now >= NextWanderTime)
+	{
+		WanderDirection = FVector(FMath::RandPointInCircle(1.0f), 0.0f).GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+		NextWanderTime = Now + WanderInterval * FMath::FRandRange(0.5f, 1.5f);
+	}
+	Character->AddMovementInput(WanderDirection);
+
+	if (Now >= NextRetargetTime)
+	{
+		UpdateTarget(Character);
+		NextRetargetTime = Now + RetargetInterval;
+	}
+
+	// Player aim follows the camera (see UDodgerCombatComponent), which follows control rotation
+	const AActor* TargetActor = Target.Get();
+	const bool bInRange = TargetActor && FVector::DistSquared(TargetActor->GetActorLocation(), Character->GetActorLocation()) <= FMath::Square(FireRange);
+	if (bInRange)
+	{
+		PlayerController->SetControlRotation((TargetActor->GetActorLocation() - Character->GetPawnViewLocation()).Rotation());
+	}
+
+	IDodgerCombatInterface* Combat = Character;
+	if (bInRange != bFireIntent)
+	{
+		Combat->SetFireIntent(bInRange);
+		bFireIntent = bInRange;
+	}
+
+	// Dodge intent is held for one tick, like a short key press
+	if (bDodgeIntent)
+	{
+		Combat->SetDodgeIntent(false);
+		bDodgeIntent = false;
+	}
+	else if (Now >= NextDodgeTime)
+	{
+		Combat->SetDodgeIntent(true);
+		bDodgeIntent = true;
+		NextDodgeTime = Now + DodgeInterval * FMath::FRandRange(0.5f, 1.5f);
+	}
+}
+
+void UDodgerSoakBotComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseIntents();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UDodgerSoakBotComponent::UpdateTarget(const ADodgerCharacter* Character)
+{
+	// Clients only see relevant characters, which is what a player would pick from too
+	ADodgerCharacter* Nearest = nullptr;
+	double NearestDistSq = UE_BIG_NUMBER;
+	for (TActorIterator<ADodgerCharacter> It(GetWorld()); It; ++It)
+	{
+		if (*It == Character || It->GetHealth() <= 0.0f)
+		{
+			continue;
+		}
+
+		const double DistSq = FVector::DistSquared(Character->GetActorLocation(), It->GetActorLocation());
+		if (DistSq < NearestDistSq)
+		{
+			NearestDistSq = DistSq;
+			Nearest = *It;
+		}
+	}
+	Target = Nearest;
+}
+
+void UDodgerSoakBotComponent::ReleaseIntents()
+{
+	if (ADodgerCharacter* Character = ControlledCharacter.Get())
+	{
+		Character->SetFireIntent(false);
+		Character->SetDodgeIntent(false);
+	}
+	bFireIntent = false;
+	bDodgeIntent = false;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DodgerSoakBotComponent.generated.h"
+
+class ADodgerCharacter;
+
+/**
+ * Scripted player for soak tests, drives the possessed character like a human would - movement input,
+ * control rotation and IDodgerCombatInterface intents, so everything goes through the regular client
+ * prediction and server RPC paths. Added to local player controllers only with -DodgerBot.
+ */
+UCLASS()
+class DODGER_API UDodgerSoakBotComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UDodgerSoakBotComponent();
+
+	static bool IsRequested();
+
+protected:
+	// Base Interface Start
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// Base Interface End
+
+private:
+	void UpdateTarget(const ADodgerCharacter* Character);
+	void ReleaseIntents();
+
+	// Time between picking the nearest living character as target
+	UPROPERTY(EditAnywhere)
+	float RetargetInterval = 0.5f;
+
+	// Average time between wander direction changes
+	UPROPERTY(EditAnywhere)
+	float WanderInterval = 2.0f;
+
+	UPROPERTY(EditAnywhere)
+	float DodgeInterval = 3.0f;
+
+	// Fire only at targets closer than this
+	UPROPERTY(EditAnywhere)
+	float FireRange = 3000.0f;
+
+	TWeakObjectPtr<ADodgerCharacter> ControlledCharacter;
+	TWeakObjectPtr<AActor> Target;
+	FVector WanderDirection = FVector::ForwardVector;
+	double NextRetargetTime = 0.0;
+	double NextWanderTime = 0.0;
+	double NextDodgeTime = 0.0;
+	bool bFireIntent = false;
+	bool bDodgeIntent = false;
+};
@@ -2,9 +2,18 @@
 
 #include "HitValidationComponent.h"
 
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
 #include "Components/BoxComponent.h"
+#include "Dodger/DamageManager.h"
 #include "Dodger/DodgerCharacter.h"
+#include "Dodger/DodgerNetAccounting.h"
+#include "Dodger/DodgerSoakRecorder.h"
+#include "Dodger/DodgerStats.h"
+#include "Dodger/DodgerStressTimings.h"
+#include "Dodger/HitboxPoseCache.h"
 #include "Dodger/Data/ProjectileConfig.h"
+#include "Engine/SkeletalMesh.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/GameplayStaticsTypes.h"
 
@@ -28,14 +37,26 @@ void UHitValidationComponent::ServerReconcileProjectileHit_Implementation(ADodge
 
 	if (Confirm.bIsValidHit)
 	{
-		const float Damage = GetDefault<UProjectileConfig>()->Damage * (Confirm.bIsHeadshot ? 2.0f : 1.0f);
+		DODGER_INC_COUNTER(STAT_DodgerHitsConfirmed, 1);
+		
 		AController* Controller = Cast<APawn>(GetOwner())->GetController();
-		UGameplayStatics::ApplyDamage(TargetCharacter, Damage, Controller, GetOwner(), UDamageType::StaticClass());
+		UDamageManager::Get(this)->QueueHit(TargetCharacter, GetDefault<UProjectileConfig>()->GetHitDamage(Confirm.bIsHeadshot), Confirm.bIsHeadshot, Controller, GetOwner());
+	}
+	else
+	{
+		DODGER_INC_COUNTER(STAT_DodgerHitsRejected, 1);
+	}
+
+	if (UDodgerSoakRecorder* SoakRecorder = UDodgerSoakRecorder::Get(this))
+	{
+		SoakRecorder->RecordHitVerification(Confirm.bIsValidHit);
 	}
 }
 
 void UHitValidationComponent::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Dodger_HitValidation);
+	
 	Super::BeginPlay();
 
 	if (GetWorld()->IsNetMode(NM_ListenServer) || GetWorld()->IsNetMode(NM_DedicatedServer))
@@ -43,6 +64,11 @@ void UHitValidationComponent::BeginPlay()
 		OwnerCharacter = Cast<ADodgerCharacter>(GetOwner());
 		FrameHistory = MakeUnique<TCircularBuffer<FCharacterFrameData>>(MaxFrameHistory);
 		SetComponentTickEnabled(true);
+
+		if (bUseServerHitboxPose && GetWorld()->IsNetMode(NM_DedicatedServer))
+		{
+			InitServerHitboxPose();
+		}
 	}
 }
 
@@ -50,15 +76,143 @@ void UHitValidationComponent::TickComponent(float DeltaTime, ELevelTick TickType
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	DODGER_STRESS_TIMING_SCOPE("HitValidation");
+
 	// this runs on server only - character is cached server side
 	if (OwnerCharacter)
 	{
+		UpdateServerHitboxPose();
 		SaveCurrentFrame();
 	}
 }
 
+void UHitValidationComponent::InitServerHitboxPose()
+{
+	USkeletalMeshComponent* Mesh = OwnerCharacter->GetMesh();
+	const USkeleton* Skeleton = Mesh && Mesh->GetSkeletalMeshAsset() ? Mesh->GetSkeletalMeshAsset()->GetSkeleton() : nullptr;
+	if (!Skeleton)
+	{
+		UE_LOG(HitValidationLog, Warning, TEXT("[%hs] %s has no skeleton, using animated hitboxes."), __func__, *GetNameSafe(OwnerCharacter));
+		return;
+	}
+
+	// Pose is evaluated only outside montages (see UpdateServerHitboxPose), read after the mesh ticked this frame
+	Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	AddTickPrerequisiteComponent(Mesh);
+
+	for (const auto& KeyVal : OwnerCharacter->GetHitBoxes())
+	{
+		UBoxComponent* Hitbox = KeyVal.Value;
+		if (!Hitbox || Hitbox->GetAttachParent() != Mesh || Hitbox->GetAttachSocketName().IsNone())
+		{
+			continue;
+		}
+
+		FServerHitbox& ServerHitbox = ServerHitboxes.AddDefaulted_GetRef();
+		ServerHitbox.Hitbox = Hitbox;
+		ServerHitbox.BoneRelativeTransform = Hitbox->GetRelativeTransform();
+		ServerHitboxBones.Add(Hitbox->GetAttachSocketName());
+
+		// Stale bones would drag hitboxes along - keep them relative to the mesh component instead
+		Hitbox->AttachToComponent(Mesh, FAttachmentTransformRules::KeepRelativeTransform, NAME_None);
+	}
+
+	// Evaluated pose only needs the chains of the hitbox bones - hidden bones and their children drop out of the required bones
+	const FReferenceSkeleton& RefSkeleton = Mesh->GetSkeletalMeshAsset()->GetRefSkeleton();
+	TBitArray<> HitboxChainBones(false, RefSkeleton.GetNum());
+	for (const FName& Bone : ServerHitboxBones)
+	{
+		for (int32 BoneIndex = RefSkeleton.FindBoneIndex(Bone); BoneIndex != INDEX_NONE && !HitboxChainBones[BoneIndex]; BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+		{
+			HitboxChainBones[BoneIndex] = true;
+		}
+	}
+	for (int32 BoneIndex = 1; BoneIndex < RefSkeleton.GetNum(); ++BoneIndex)
+	{
+		const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+		if (!HitboxChainBones[BoneIndex] && HitboxChainBones[ParentIndex])
+		{
+			Mesh->HideBone(BoneIndex, PBO_None);
+		}
+	}
+	Mesh->RecalcRequiredBones(Mesh->GetPredictedLODLevel());
+
+	UpdateServerHitboxPose();
+}
+
+void UHitValidationComponent::UpdateServerHitboxPose()
+{
+	if (ServerHitboxes.IsEmpty())
+	{
+		return;
+	}
+
+	USkeletalMeshComponent* Mesh = OwnerCharacter->GetMesh();
+
+	// Ragdoll - physics drives the bodies, nothing to validate against
+	if (Mesh->IsSimulatingPhysics())
+	{
+		return;
+	}
+
+	// Whether this frame's animation tick evaluated the pose, read before the tick option changes below
+	const bool bPoseEvaluated = Mesh->VisibilityBasedAnimTickOption == EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	const UAnimInstance* AnimInstance = Mesh->GetAnimInstance();
+	const FAnimMontageInstance* MontageInstance = AnimInstance ? AnimInstance->GetActiveMontageInstance() : nullptr;
+	const bool bMontageActive = MontageInstance != nullptr;
+
+	// First frame after the montage started blending out (or ended) has no evaluated pose yet - keep sampling the
+	// most recent montage while it is still there
+	if (!bMontageActive && !bPoseEvaluated && AnimInstance)
+	{
+		for (const FAnimMontageInstance* Instance : AnimInstance->MontageInstances)
+		{
+			if (Instance && Instance->Montage)
+			{
+				MontageInstance = Instance;
+			}
+		}
+	}
+
+	const FHitboxBoneTracks* Tracks = nullptr;
+	if (MontageInstance && MontageInstance->Montage)
+	{
+		Tracks = UHitboxPoseCache::Get(this)->FindOrBake(MontageInstance->Montage, Mesh->GetSkeletalMeshAsset()->GetSkeleton(), ServerHitboxBones);
+	}
+
+	// Active montages play from baked tracks and only tick (notifies, root motion, montage position). Idle, locomotion
+	// and montage blend outs come from the evaluated pose of the hitbox bone chains
+	const EVisibilityBasedAnimTickOption TickOption = bMontageActive && Tracks
+		? EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered
+		: EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	if (Mesh->VisibilityBasedAnimTickOption != TickOption)
+	{
+		Mesh->VisibilityBasedAnimTickOption = TickOption;
+	}
+
+	// Montage gone without tracks to fall back to - evaluate now rather than record a stale pose
+	const bool bSampleTracks = Tracks && (bMontageActive || !bPoseEvaluated);
+	if (!bSampleTracks && !bPoseEvaluated)
+	{
+		Mesh->RefreshBoneTransforms();
+	}
+
+	for (int32 Index = 0; Index < ServerHitboxes.Num(); ++Index)
+	{
+		const FServerHitbox& ServerHitbox = ServerHitboxes[Index];
+		if (UBoxComponent* Hitbox = ServerHitbox.Hitbox.Get())
+		{
+			const FTransform BoneTransform = bSampleTracks ? Tracks->Sample(Index, MontageInstance->GetPosition()) : Mesh->GetSocketTransform(ServerHitboxBones[Index], RTS_Component);
+			Hitbox->SetRelativeTransform(ServerHitbox.BoneRelativeTransform * BoneTransform);
+		}
+	}
+}
+
 FHitVerificationResult UHitValidationComponent::VerifyProjectileHit(ADodgerCharacter* TargetCharacter, const FVector_NetQuantize& TraceStart,const FVector_NetQuantize100& InitialVelocity, float HitTime) const
 {
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerHitValidationVerify);
+	
 	if (TargetCharacter)
 	{
 		const FCharacterFrameData FrameToCheck = FindRewindFrame(TargetCharacter, HitTime);
@@ -71,6 +225,9 @@ FHitVerificationResult UHitValidationComponent::VerifyProjectileHit(ADodgerChara
 
 void UHitValidationComponent::SaveCurrentFrame()
 {
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerHitValidationSave);
+	LLM_SCOPE_BYTAG(Dodger_HitValidation);
+	
 	FCharacterFrameData CurrentFrame;
 	CaptureCharacterFrame(CurrentFrame);
 	(*FrameHistory)[FrameCounter++] = MoveTemp(CurrentFrame);
@@ -80,12 +237,14 @@ void UHitValidationComponent::CaptureCharacterFrame(FCharacterFrameData& OutFram
 {
 	OutFrameData.Timestamp = GetWorld()->GetTimeSeconds();
 	OutFrameData.Character = OwnerCharacter;
-	OutFrameData.bIsInvulnerable = OwnerCharacter->IsInvulnerable();
+	OutFrameData.bIsInvulnerable = IsInvulnerableAt(OutFrameData.Timestamp);
 	CaptureHitboxPositions(OwnerCharacter, OutFrameData);
 }
 
 FCharacterFrameData UHitValidationComponent::FindRewindFrame(ADodgerCharacter* TargetCharacter, float HitTime) const
 {
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerHitValidationRewind);
+	
 	static const FCharacterFrameData InvalidFrame;
 
 	// Early out if we have no frame history
@@ -105,24 +264,77 @@ FCharacterFrameData UHitValidationComponent::FindRewindFrame(ADodgerCharacter* T
 		OlderIndex--;
 	}
 
+	FCharacterFrameData RewindFrame = InvalidFrame;
+
 	// Found an exact timestamp match (rare but possible)
 	if (FMath::IsNearlyEqual((*FrameHistory)[OlderIndex].Timestamp, HitTime))
 	{
-		return (*FrameHistory)[OlderIndex];
+		RewindFrame = (*FrameHistory)[OlderIndex];
 	}
 	// Need interpolation
-	if (OlderIndex != CurrentIndex)
+	else if (OlderIndex != CurrentIndex)
 	{
-		return InterpolateFrames((*FrameHistory)[OlderIndex], (*FrameHistory)[CurrentIndex], HitTime);
+		RewindFrame = InterpolateFrames((*FrameHistory)[OlderIndex], (*FrameHistory)[CurrentIndex], HitTime);
 	}
-	
 	// HitTime is newer than our newest frame
-	if (HitTime >= (*FrameHistory)[CurrentIndex].Timestamp)
+	else if (HitTime >= (*FrameHistory)[CurrentIndex].Timestamp)
 	{
-		return (*FrameHistory)[CurrentIndex];
+		RewindFrame = (*FrameHistory)[CurrentIndex];
+	}
+	else
+	{
+		return InvalidFrame;
 	}
 
-	return InvalidFrame;
+	// Invulnerability is exact at the hit time, not sampled per frame
+	RewindFrame.bIsInvulnerable = IsInvulnerableAt(HitTime);
+	return RewindFrame;
+}
+
+void UHitValidationComponent::ResetHistory()
+{
+	FrameCounter = 0;
+	InvulnerabilityWindows.Reset();
+}
+
+SIZE_T UHitValidationComponent::GetAllocatedSize() const
+{
+	SIZE_T Size = InvulnerabilityWindows.GetAllocatedSize() + ServerHitboxes.GetAllocatedSize() + ServerHitboxBones.GetAllocatedSize();
+	if (FrameHistory)
+	{
+		Size += FrameHistory->Capacity() * sizeof(FCharacterFrameData);
+		for (uint32 Index = 0; Index < FrameHistory->Capacity(); ++Index)
+		{
+			Size += (*FrameHistory)[Index].HitboxData.GetAllocatedSize();
+		}
+	}
+	return Size;
+}
+
+void UHitValidationComponent::RecordInvulnerabilityWindow(float StartTime, float EndTime)
+{
+	// Forget windows older than the rewind history
+	const float HistoryDuration = MaxFrameHistory * FMath::Max(PrimaryComponentTick.TickInterval, UE_KINDA_SMALL_NUMBER);
+	const float OldestTime = GetWorld()->GetTimeSeconds() - HistoryDuration;
+	InvulnerabilityWindows.RemoveAll([OldestTime](const FInvulnerabilityWindow& Window)
+	{
+		return Window.EndTime < OldestTime;
+	});
+
+	InvulnerabilityWindows.Add({StartTime, EndTime});
+}
+
+bool UHitValidationComponent::IsInvulnerableAt(float ServerTime) const
+{
+	for (const FInvulnerabilityWindow& Window : InvulnerabilityWindows)
+	{
+		if (ServerTime >= Window.StartTime && ServerTime <= Window.EndTime)
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
 
 FCharacterFrameData UHitValidationComponent::InterpolateFrames(const FCharacterFrameData& OlderFrame, const FCharacterFrameData& YoungerFrame, float HitTime) const
@@ -268,3 +480,12 @@ void UHitValidationComponent::RestoreCharacterHitboxes(ADodgerCharacter* TargetC
 	}
 }
 
+bool UHitValidationComponent::CallRemoteFunction(UFunction* Function, void* Parms, FOutParmRec* OutParms, FFrame* Stack)
+{
+	if (UDodgerNetAccounting* NetAccounting = UDodgerNetAccounting::Get(this))
+	{
+		NetAccounting->RecordRemoteFunction(GetOwner(), Function, Parms);
+	}
+
+	return Super::CallRemoteFunction(Function, Parms, OutParms, Stack);
+}
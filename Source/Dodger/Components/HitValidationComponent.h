@@ -7,6 +7,7 @@
 #include "HitValidationComponent.generated.h"
 
 class ADodgerCharacter;
+class UBoxComponent;
 
 UCLASS(Within=DodgerCharacter)
 class UHitValidationComponent : public UActorComponent
@@ -20,16 +21,37 @@ public:
 	 */
 	UFUNCTION(Server, Reliable)
 	void ServerReconcileProjectileHit(ADodgerCharacter* TargetCharacter, const FVector_NetQuantize& TraceStart, const FVector_NetQuantize100& InitialVelocity, float HitTime);
+	/**
+	 * Record invulnerability window on the server timeline (server only).
+	 */
+	void RecordInvulnerabilityWindow(float StartTime, float EndTime);
+	/**
+	 * Whether owner is invulnerable at given server time according to recorded windows.
+	 */
+	bool IsInvulnerableAt(float ServerTime) const;
+	/**
+	 * Forget frame history and invulnerability windows (e.g. pooled character reused).
+	 */
+	void ResetHistory();
+	/**
+	 * Memory owned by frame history, windows and server hitboxes (see UDodgerMemoryTracker).
+	 */
+	SIZE_T GetAllocatedSize() const;
 protected:
 	// Base Interface Start
 	virtual void BeginPlay() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parms, FOutParmRec* OutParms, FFrame* Stack) override;
 	// Base Interface End
 
 private:
 	// Verify hit with server-side rewind
 	FHitVerificationResult VerifyProjectileHit(ADodgerCharacter* TargetCharacter, const FVector_NetQuantize& TraceStart, const FVector_NetQuantize100& InitialVelocity, float HitTime) const;
 	
+	// Server hitbox pose - baked bone tracks during montages, otherwise the evaluated hitbox bone chains only
+	void InitServerHitboxPose();
+	void UpdateServerHitboxPose();
+
 	// Frame history management
 	void SaveCurrentFrame();
 	void CaptureCharacterFrame(FCharacterFrameData& OutFrameData);
@@ -51,8 +73,24 @@ private:
 	UPROPERTY(EditAnywhere)
 	int32 MaxFrameHistory = 240; // ~4 seconds at 60fps
 
+	// Dedicated server places hitboxes from baked montage bone tracks during montages instead of evaluating the pose
+	UPROPERTY(EditAnywhere)
+	bool bUseServerHitboxPose = true;
+
+	struct FServerHitbox
+	{
+		TWeakObjectPtr<UBoxComponent> Hitbox;
+		// Hitbox transform relative to its bone
+		FTransform BoneRelativeTransform;
+	};
+	TArray<FServerHitbox> ServerHitboxes;
+	TArray<FName> ServerHitboxBones;
+
 	TUniquePtr<TCircularBuffer<FCharacterFrameData>> FrameHistory;
 	uint32 FrameCounter = 0;
+
+	// Invulnerability windows on server timeline, oldest first
+	TArray<FInvulnerabilityWindow> InvulnerabilityWindows;
 	
 	UPROPERTY(Transient)
 	TObjectPtr<ADodgerCharacter> OwnerCharacter = nullptr;
@@ -0,0 +1,97 @@
+
+#include "DamageManager.h"
+
+#include "DodgerCharacter.h"
+#include "DodgerNetTypes.h"
+#include "DodgerStats.h"
+#include "DodgerStressTimings.h"
+
+UDamageManager* UDamageManager::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UDamageManager>();
+	}
+
+	return nullptr;
+}
+
+bool UDamageManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDamageManager::QueueHit(ADodgerCharacter* Victim, float Damage, bool bHeadshot, AController* InstigatorController, AActor* DamageCauser)
+{
+	if (!Victim)
+	{
+		return;
+	}
+
+	FQueuedHit& Hit = QueuedHits.AddDefaulted_GetRef();
+	Hit.Victim = Victim;
+	Hit.InstigatorController = InstigatorController;
+	Hit.DamageCauser = DamageCauser;
+	Hit.Damage = Damage;
+	Hit.bHeadshot = bHeadshot;
+	Hit.VictimId = Victim->GetUniqueID();
+	Hit.Order = NextHitOrder++;
+}
+
+void UDamageManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DODGER_STRESS_TIMING_SCOPE("Damage");
+
+	if (QueuedHits.Num() > 0)
+	{
+		ResolveHits();
+	}
+}
+
+TStatId UDamageManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDamageManager, STATGROUP_Tickables);
+}
+
+void UDamageManager::ResolveHits()
+{
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerResolveDamage);
+	
+	// Group hits per victim, keep queue order inside a group
+	QueuedHits.Sort([](const FQueuedHit& A, const FQueuedHit& B)
+	{
+		return A.VictimId != B.VictimId ? A.VictimId < B.VictimId : A.Order < B.Order;
+	});
+
+	for (int32 GroupStart = 0; GroupStart < QueuedHits.Num();)
+	{
+		const uint32 VictimId = QueuedHits[GroupStart].VictimId;
+
+		float TotalDamage = 0.0f;
+		bool bAnyHeadshot = false;
+		int32 GroupEnd = GroupStart;
+		for (; GroupEnd < QueuedHits.Num() && QueuedHits[GroupEnd].VictimId == VictimId; ++GroupEnd)
+		{
+			TotalDamage += QueuedHits[GroupEnd].Damage;
+			bAnyHeadshot |= QueuedHits[GroupEnd].bHeadshot;
+		}
+
+		// Last hit of the frame is credited (instigator, final blow direction)
+		const FQueuedHit& LastHit = QueuedHits[GroupEnd - 1];
+		if (ADodgerCharacter* Victim = LastHit.Victim.Get())
+		{
+			FDodgerDamageResult Result;
+			Result.SetDamage(TotalDamage);
+			Result.HitCount = static_cast<uint8>(FMath::Min(GroupEnd - GroupStart, static_cast<int32>(MAX_uint8)));
+			Result.bHeadshot = bAnyHeadshot;
+			Victim->ApplyResolvedDamage(Result, TotalDamage, LastHit.InstigatorController.Get(), LastHit.DamageCauser.Get());
+		}
+
+		GroupStart = GroupEnd;
+	}
+
+	QueuedHits.Reset();
+	NextHitOrder = 0;
+}
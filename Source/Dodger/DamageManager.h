@@ -0,0 +1,54 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DamageManager.generated.h"
+
+class ADodgerCharacter;
+
+/**
+ * Collects hits during the frame and resolves them in one deterministic pass (server only).
+ * Multiple hits on the same victim are merged into a single health change and replicated result.
+ */
+UCLASS()
+class DODGER_API UDamageManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDamageManager* Get(const UObject* WorldContext);
+	/**
+	 *  Queue a verified hit, damage is applied at the end of the frame.
+	 *  Damage is final (headshot multiplier of the projectile's config already applied)
+	 */
+	void QueueHit(ADodgerCharacter* Victim, float Damage, bool bHeadshot, AController* InstigatorController, AActor* DamageCauser);
+	
+	// Base Interface Start
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	
+private:
+	struct FQueuedHit
+	{
+		TWeakObjectPtr<ADodgerCharacter> Victim;
+		TWeakObjectPtr<AController> InstigatorController;
+		TWeakObjectPtr<AActor> DamageCauser;
+		float Damage = 0.0f;
+		bool bHeadshot = false;
+		// Victim id and queue order - sort key making resolution independent of container layout
+		uint32 VictimId = 0;
+		uint32 Order = 0;
+	};
+	/**
+	 *  Merge and apply all queued hits
+	 */
+	void ResolveHits();
+	
+	TArray<FQueuedHit> QueuedHits;
+	uint32 NextHitOrder = 0;
+};
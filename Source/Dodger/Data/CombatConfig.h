@@ -42,4 +42,10 @@ public:
 	 */
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	float AimOffset = 70.0f;
+	/**
+	 * Oldest client attack/dodge timestamp (in seconds behind server time) accepted by server.
+	 * Older requests are clamped, so high ping can't move actions arbitrarily far into the past.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Network")
+	float MaxPredictionTime = 0.4f;
 };
\ No newline at end of file
@@ -3,8 +3,6 @@
 #include "Engine/DataAsset.h"
 #include "EnemyConfig.generated.h"
 
-class UAISenseConfig;
-
 UCLASS()
 class UEnemyConfig : public UDataAsset
 {
@@ -28,11 +26,26 @@ public:
      */
     UPROPERTY(EditAnywhere, Category = "Patrol")
     float PatrolWalkSpeed = 200.0f;
+    /**
+     * Number of precomputed patrol points kept per enemy. The AI manager tops them up on the game thread, a few navmesh queries per frame.
+     */
+    UPROPERTY(EditAnywhere, Category = "Patrol")
+    int32 PatrolPointCacheSize = 8;
     /**
      * Distance at which enemy will start chasing the player.
      */
     UPROPERTY(EditAnywhere, Category = "Chase")
     float ChaseStartDistance = 800.0f;
+    /**
+     * Size of the stimulus grid cells. Around chase start distance keeps queries within a few cells.
+     */
+    UPROPERTY(EditAnywhere, Category = "Perception")
+    float StimulusCellSize = 1000.0f;
+    /**
+     * How long (in seconds) noise events stay audible. Should cover the slowest AI update interval.
+     */
+    UPROPERTY(EditAnywhere, Category = "Perception")
+    float NoiseLifetime = 1.0f;
     /**
      * Distance at which enemy will stop chasing the player.
      */
@@ -43,6 +56,16 @@ public:
      */
     UPROPERTY(EditAnywhere, Category = "Chase")
     float ChaseWalkSpeed = 400.0f;
+    /**
+     * Cell size of the shared chase flow fields.
+     */
+    UPROPERTY(EditAnywhere, Category = "Chase")
+    float FlowFieldCellSize = 100.0f;
+    /**
+     * Distance from the chased target covered by its flow field. Enemies further away use regular path following.
+     */
+    UPROPERTY(EditAnywhere, Category = "Chase")
+    float FlowFieldExtent = 2500.0f;
     /**
      * Distance at which enemy enters fighting state.
      */
@@ -54,6 +77,28 @@ public:
      */
     UPROPERTY(EditAnywhere, Category = "Attack")
     float AttackRangeOffset = 100.0f;
+    /**
+     * Distance to the nearest player under which the enemy updates at its fastest rate.
+     */
+    UPROPERTY(EditAnywhere, Category = "Update LOD")
+    float FullRateDistance = 1500.0f;
+    /**
+     * Distance to the nearest player at which the enemy updates at its slowest rate.
+     */
+    UPROPERTY(EditAnywhere, Category = "Update LOD")
+    float MinRateDistance = 6000.0f;
+    /**
+     * Update interval (in seconds) in Idle and Patrol state.
+     * X = interval near players, Y = interval far from players.
+     */
+    UPROPERTY(EditAnywhere, Category = "Update LOD")
+    FVector2D IdleUpdateInterval = {0.25f, 1.0f};
+    /**
+     * Update interval (in seconds) in Chase state. Combat always updates every frame.
+     * X = interval near players, Y = interval far from players.
+     */
+    UPROPERTY(EditAnywhere, Category = "Update LOD")
+    FVector2D ChaseUpdateInterval = {0.0f, 0.2f};
     /**
      * Primary color used for this enemy body.
      */
@@ -65,8 +110,15 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
     FName ColorParamName = TEXT("Tint");
     /**
-     * Configuration for AI perception (sight, hearing, etc.).
+     * Write EnemyColor into custom primitive data instead of creating dynamic material instances.
+     * Materials need to read the tint from custom primitive data at TintCustomDataIndex (4 floats),
+     * the shared enemy material still reads the ColorParamName parameter - enable once it's converted.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
+    bool bUseCustomPrimitiveDataTint = false;
+    /**
+     * First custom primitive data index of the tint.
      */
-    UPROPERTY(EditAnywhere, Instanced, Category = "Visuals")
-    TObjectPtr<UAISenseConfig> AISenseConfig;
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals", meta = (EditCondition = "bUseCustomPrimitiveDataTint"))
+    int32 TintCustomDataIndex = 0;
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "EnemySpawnTable.generated.h"
+
+class ADodgerCharacter;
+
+USTRUCT()
+struct FEnemyWave
+{
+	GENERATED_BODY()
+	/**
+	 * Enemy character class, its AIControllerClass has to be an AEnemyAIController.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Wave")
+	TSubclassOf<ADodgerCharacter> EnemyClass;
+	/**
+	 * Number of enemies spawned in this wave.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Wave", meta = (ClampMin = 1))
+	int32 Count = 5;
+	/**
+	 * Delay (in seconds) after previous wave was cleared before this wave starts.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Wave")
+	float StartDelay = 5.0f;
+	/**
+	 * Time (in seconds) between individual spawns of the wave.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Wave")
+	float SpawnInterval = 0.25f;
+};
+
+UCLASS()
+class UEnemySpawnTable : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Waves in order of spawning.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Waves")
+	TArray<FEnemyWave> Waves;
+	/**
+	 * Start over from the first wave after the last one was cleared.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Waves")
+	bool bLoopWaves = true;
+	/**
+	 * Enemies returning to the pool are spawned again, so the current wave keeps its count instead of being cleared.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Waves")
+	bool bRespawnReleased = false;
+	/**
+	 * Enemies spawn at random reachable points within this radius around a random player start.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	float SpawnRadius = 2000.0f;
+	/**
+	 * Time (in seconds) a dead enemy stays as a ragdoll before returning to the pool.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	float CorpseLifetime = 5.0f;
+	/**
+	 * Enemies of each wave class created up front (when waves start) so spawning never creates actors.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Pooling")
+	int32 PrewarmCount = 10;
+};
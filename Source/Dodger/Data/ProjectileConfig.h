@@ -32,6 +32,15 @@ public:
 	 */
 	UPROPERTY(EditAnywhere, Category = "Damage")
 	float Damage = 20.0f;
+	/**
+	 * Damage multiplier applied to hits on the head hitbox
+	 */
+	UPROPERTY(EditAnywhere, Category = "Damage")
+	float HeadshotMultiplier = 2.0f;
+	/**
+	 * Damage of one hit, headshots scaled by HeadshotMultiplier
+	 */
+	float GetHitDamage(bool bHeadshot) const { return Damage * (bHeadshot ? HeadshotMultiplier : 1.0f); }
 	/**
 	 * Sound played when the projectile hits a target
 	 */
@@ -0,0 +1,35 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "ReplicationGraphConfig.generated.h"
+
+/**
+ * Settings of UDodgerReplicationGraph, edited in Project Settings (DefaultEngine.ini next to ReplicationDriverClassName).
+ */
+UCLASS(Config = Engine, DefaultConfig, meta = (DisplayName = "Dodger Replication Graph"))
+class UReplicationGraphConfig : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Size of spatial grid cells - connections only gather actors from cells within the actor's cull distance.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Grid")
+	float CellSize = 10000.0f;
+	/**
+	 * Grid origin offset, should place the whole playable area at positive coordinates.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Grid")
+	FVector2D SpatialBias = FVector2D(-150000.0, -150000.0);
+	/**
+	 * Skip rebuilding the grid when actors leave its bounds (rebuild is a hitch with many actors).
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Grid")
+	bool bDisableSpatialRebuilds = true;
+	/**
+	 * Replication rate (per second) of dead characters - ragdolls are simulated locally, only corpse state is left.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Characters")
+	float DeadCharacterUpdateFrequency = 1.0f;
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "SignificanceConfig.generated.h"
+
+USTRUCT()
+struct FDodgerSignificanceTier
+{
+	GENERATED_BODY()
+
+	FDodgerSignificanceTier() = default;
+	FDodgerSignificanceTier(float InMinSignificance, float InTickInterval, int32 InAnimFrameSkip, EVisibilityBasedAnimTickOption InAnimTickOption)
+		: MinSignificance(InMinSignificance), TickInterval(InTickInterval), AnimFrameSkip(InAnimFrameSkip), AnimTickOption(InAnimTickOption)
+	{
+	}
+	/**
+	 * Characters with significance at or above this value use this tier.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Tier")
+	float MinSignificance = 0.0f;
+	/**
+	 * Tick interval (in seconds) of the actor, its movement and mesh. 0 = every frame.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Tier")
+	float TickInterval = 0.0f;
+	/**
+	 * Animation frames skipped between updates (update rate optimizations). 0 = every frame.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Tier")
+	int32 AnimFrameSkip = 0;
+	/**
+	 * Mesh tick option - montages have to keep ticking, combat state is driven by montage events.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Tier")
+	EVisibilityBasedAnimTickOption AnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+};
+
+/**
+ * Significance scoring and tiers of UDodgerSignificanceManager, edited in Project Settings (DefaultGame.ini).
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Dodger Significance"))
+class USignificanceConfig : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	USignificanceConfig()
+	{
+		Tiers = {
+			{0.75f, 0.0f, 0, EVisibilityBasedAnimTickOption::AlwaysTickPose},
+			{0.4f, 0.033f, 1, EVisibilityBasedAnimTickOption::AlwaysTickPose},
+			{0.15f, 0.1f, 3, EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered},
+			{0.0f, 0.25f, 6, EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered},
+		};
+	}
+	/**
+	 * Distance from the closest viewpoint at which distance stops contributing to significance.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Scoring")
+	float MaxDistance = 8000.0f;
+	/**
+	 * Significance multiplier of characters not rendered recently (behind walls, off screen).
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Scoring")
+	float NotRenderedScale = 0.5f;
+	/**
+	 * Significance added while the character attacks, dodges or is dying.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Scoring")
+	float CombatBonus = 0.5f;
+	/**
+	 * Tiers ordered from the most significant.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Tiers")
+	TArray<FDodgerSignificanceTier> Tiers;
+};
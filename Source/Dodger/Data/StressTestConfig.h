@@ -0,0 +1,63 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "StressTestConfig.generated.h"
+
+class ADodgerCharacter;
+
+/**
+ * Settings of the -DodgerStressTest scenario, edited in Project Settings (DefaultGame.ini).
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Dodger Stress Test"))
+class UStressTestConfig : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Enemy character, its AIControllerClass has to be an AEnemyAIController (spawned through UEnemySpawner).
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Spawning")
+	TSoftClassPtr<ADodgerCharacter> EnemyClass = TSoftClassPtr<ADodgerCharacter>(FSoftObjectPath(TEXT("/Game/AI/BP_EnemyCharacter.BP_EnemyCharacter_C")));
+	/**
+	 * Bot player character, possessed by an ADodgerBotController.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Spawning")
+	TSoftClassPtr<ADodgerCharacter> BotClass = TSoftClassPtr<ADodgerCharacter>(FSoftObjectPath(TEXT("/Game/Characters/BP_DodgerCharacter.BP_DodgerCharacter_C")));
+	/**
+	 * Number of enemies, overridden by -StressEnemies=
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Spawning")
+	int32 NumEnemies = 200;
+	/**
+	 * Number of bot players, overridden by -StressBots=
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Spawning")
+	int32 NumBots = 8;
+	/**
+	 * Enemies and bots spawn at random reachable points within this radius around player starts.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Spawning")
+	float SpawnRadius = 4000.0f;
+	/**
+	 * Time (in seconds) after spawning excluded from measurements.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Timing")
+	float WarmupTime = 5.0f;
+	/**
+	 * Measured duration (in seconds), split evenly between idle/patrol, chase and combat phases.
+	 * Overridden by -StressDuration=
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Timing")
+	float Duration = 120.0f;
+	/**
+	 * Time (in seconds) dead enemies stay before returning to the pool to be spawned again.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Timing")
+	float EnemyRespawnDelay = 2.0f;
+	/**
+	 * Time (in seconds) between dodges of a bot in combat phase.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Bots")
+	float BotDodgeInterval = 3.0f;
+};
@@ -6,9 +6,12 @@ public class Dodger : ModuleRules
 {
 	public Dodger(ReadOnlyTargetRules Target) : base(Target)
 	{
-		PrivateDependencyModuleNames.AddRange(new string[] { "Niagara", "AIModule", "NavigationSystem" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "Niagara", "AIModule", "NavigationSystem", "SignificanceManager", "Json", "ReplicationGraph", "NetCore", "DeveloperSettings" });
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput" });
+
+		// Iris net serializers of combat types, legacy replication keeps working without them
+		SetupIrisSupport(Target);
 	}
 }
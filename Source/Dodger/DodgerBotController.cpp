@@ -0,0 +1,97 @@
+
+#include "DodgerBotController.h"
+
+#include "NavigationSystem.h"
+#include "Interfaces/DodgerCombatInterface.h"
+#include "Navigation/PathFollowingComponent.h"
+
+ADodgerBotController::ADodgerBotController()
+{
+	bWantsPlayerState = true;
+	
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void ADodgerBotController::SetPhase(EDodgerBotPhase NewPhase)
+{
+	if (Phase == NewPhase)
+	{
+		return;
+	}
+
+	Phase = NewPhase;
+
+	if (IDodgerCombatInterface* Combat = Cast<IDodgerCombatInterface>(GetPawn()))
+	{
+		Combat->SetFireIntent(false);
+		Combat->SetDodgeIntent(false);
+	}
+	bDodgeIntent = false;
+
+	if (Phase == EDodgerBotPhase::Idle)
+	{
+		StopMovement();
+		ClearFocus(EAIFocusPriority::Gameplay);
+	}
+}
+
+void ADodgerBotController::SetRoamArea(const FVector& Center, float Radius)
+{
+	RoamCenter = Center;
+	RoamRadius = Radius;
+}
+
+void ADodgerBotController::SetCombatTarget(AActor* NewTarget)
+{
+	CombatTarget = NewTarget;
+}
+
+void ADodgerBotController::UpdateBot(double Now)
+{
+	IDodgerCombatInterface* Combat = Cast<IDodgerCombatInterface>(GetPawn());
+	if (!Combat || Phase == EDodgerBotPhase::Idle)
+	{
+		return;
+	}
+
+	if (GetMoveStatus() == EPathFollowingStatus::Idle)
+	{
+		Roam();
+	}
+
+	if (Phase != EDodgerBotPhase::Combat)
+	{
+		return;
+	}
+
+	// Aim comes from the focus actor (see UDodgerCombatComponent)
+	AActor* Target = CombatTarget.Get();
+	if (Target != GetFocusActor())
+	{
+		SetFocus(Target, EAIFocusPriority::Gameplay);
+	}
+	Combat->SetFireIntent(Target != nullptr);
+
+	// Dodge intent is held for one update, like a short key press
+	if (bDodgeIntent)
+	{
+		Combat->SetDodgeIntent(false);
+		bDodgeIntent = false;
+	}
+	else if (Now >= NextDodgeTime)
+	{
+		Combat->SetDodgeIntent(true);
+		bDodgeIntent = true;
+		NextDodgeTime = Now + DodgeInterval;
+	}
+}
+
+void ADodgerBotController::Roam()
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	FNavLocation Destination;
+	if (NavSys && NavSys->GetRandomReachablePointInRadius(RoamCenter, RoamRadius, Destination))
+	{
+		MoveToLocation(Destination.Location);
+	}
+}
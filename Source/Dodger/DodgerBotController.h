@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "DodgerBotController.generated.h"
+
+UENUM()
+enum class EDodgerBotPhase : uint8
+{
+	// Stand still - not sensed by enemies, they idle and patrol
+	Idle,
+	// Run around the roam area - enemies notice and chase
+	Chase,
+	// Keep running, shoot the combat target and dodge
+	Combat
+};
+
+/**
+ * Headless stand-in for a player (server only, see UDodgerStressTest).
+ * Has a player state so game systems treat it as a player. Not ticked - the owner drives it with UpdateBot.
+ */
+UCLASS()
+class DODGER_API ADodgerBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	ADodgerBotController();
+
+	void SetPhase(EDodgerBotPhase NewPhase);
+	void SetRoamArea(const FVector& Center, float Radius);
+	void SetCombatTarget(AActor* NewTarget);
+	void SetDodgeInterval(float Interval) { DodgeInterval = Interval; }
+	
+	void UpdateBot(double Now);
+
+	EDodgerBotPhase GetPhase() const { return Phase; }
+
+private:
+	void Roam();
+	
+	EDodgerBotPhase Phase = EDodgerBotPhase::Idle;
+
+	FVector RoamCenter = FVector::ZeroVector;
+	float RoamRadius = 0.0f;
+
+	TWeakObjectPtr<AActor> CombatTarget;
+
+	float DodgeInterval = 3.0f;
+	double NextDodgeTime = 0.0;
+	bool bDodgeIntent = false;
+};
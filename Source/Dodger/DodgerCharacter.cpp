@@ -9,6 +9,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/Controller.h"
+#include "GameFramework/DamageType.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
@@ -16,6 +17,13 @@
 #include "Components/DodgerCombatComponent.h"
 #include "Components/HitValidationComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Dodger/StimulusManager.h"
+#include "Dodger/DodgerDormancyManager.h"
+#include "Dodger/DodgerNetAccounting.h"
+#include "Dodger/DodgerReplicationGraph.h"
+#include "Dodger/DodgerSignificanceManager.h"
+#include "Dodger/DodgerStats.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -72,6 +80,9 @@ ADodgerCharacter::ADodgerCharacter()
 	HitBoxBody->InitBoxExtent(FVector(75, 25, 32));
 	HitBoxBody->SetRelativeLocation(FVector(-20.0, 0.0, 0.0));
 	AddHitBox(HitBoxBody);
+
+	// Update rate params are only created for meshes registered with optimizations on, significance tiers tune them
+	GetMesh()->bEnableUpdateRateOptimizations = true;
 	
 }
 
@@ -86,27 +97,48 @@ void ADodgerCharacter::BeginPlay()
 		{
 			HitBoxPair.Value->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 		}
+
+		// broadcast presence while moving so enemies can sense us
+		if (UStimulusManager* StimulusManager = UStimulusManager::Get(this))
+		{
+			StimulusManager->RegisterSource(this);
+		}
+	}
+
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		// nothing is rendered - skipping frames would only make hitboxes lag
+		GetMesh()->bEnableUpdateRateOptimizations = false;
+	}
+	else if (UDodgerSignificanceManager* SignificanceManager = UDodgerSignificanceManager::Get(this))
+	{
+		SignificanceManager->RegisterCharacter(this);
+	}
+
+	if (UDodgerDormancyManager* DormancyManager = UDodgerDormancyManager::Get(this))
+	{
+		DormancyManager->RegisterCharacter(this);
 	}
 }
 
-void ADodgerCharacter::Tick(float DeltaSeconds)
+void ADodgerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaSeconds);
-	
-	CombatComponent->UpdateCombat(DeltaSeconds);
+	if (UStimulusManager* StimulusManager = UStimulusManager::Get(this))
+	{
+		StimulusManager->UnregisterSource(this);
+	}
 
-	// emmit noise so enemy can hear us
-	if (HasAuthority())
+	if (UDodgerSignificanceManager* SignificanceManager = UDodgerSignificanceManager::Get(this))
 	{
-		if (GetWorld()->TimeSince(LastNoiseEmittedTime) > 1.0)
-		{
-			if (GetVelocity().SizeSquared2D() > 1.0f)
-			{
-				LastNoiseEmittedTime = GetWorld()->GetTimeSeconds();
-				MakeNoise(1, this, GetActorLocation());
-			}
-		}
+		SignificanceManager->UnregisterCharacter(this);
 	}
+
+	if (UDodgerDormancyManager* DormancyManager = UDodgerDormancyManager::Get(this))
+	{
+		DormancyManager->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 bool ADodgerCharacter::CanJumpInternal_Implementation() const
@@ -118,20 +150,145 @@ float ADodgerCharacter::TakeDamage(float DamageAmount, const FDamageEvent& Damag
 {
 	float DamageTaken = Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
 	
+	ReduceHealth(DamageTaken, DamageCauser);
+	
+	return DamageTaken;
+}
+
+void ADodgerCharacter::ApplyResolvedDamage(FDodgerDamageResult Result, float Damage, AController* EventInstigator, AActor* DamageCauser)
+{
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerApplyDamage);
+	
+	if (!CanBeDamaged() || Health <= 0.0f)
+	{
+		return;
+	}
+
+	DODGER_INC_COUNTER(STAT_DodgerDamageApplied, 1);
+
+	// Bypasses AActor::TakeDamage - raise the same generic damage events it would
+	const UDamageType* DamageType = GetDefault<UDamageType>();
+	ReceiveAnyDamage(Damage, DamageType, EventInstigator, DamageCauser);
+	OnTakeAnyDamage.Broadcast(this, Damage, DamageType, EventInstigator, DamageCauser);
+	if (EventInstigator)
+	{
+		EventInstigator->InstigatedAnyDamage(Damage, DamageType, this, DamageCauser);
+	}
+	
+	Result.bFatal = ReduceHealth(Damage, DamageCauser);
+	Result.Serial = LastDamageResult.Serial + 1;
+	LastDamageResult = Result;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ADodgerCharacter, LastDamageResult, this);
+
+	OnDamageResult.Broadcast(this, LastDamageResult);
+}
+
+bool ADodgerCharacter::ReduceHealth(float Damage, AActor* DamageCauser)
+{
+	if (Health <= 0.0f)
+	{
+		return false;
+	}
+
+	// Dormant actors neither send properties nor the final blow multicast
+	if (UDodgerDormancyManager* DormancyManager = UDodgerDormancyManager::Get(this))
+	{
+		DormancyManager->WakeCharacter(this);
+	}
+
+	Health -= Damage;
+	CombatComponent->RefreshRepState();
+
 	// Is final hit
-	if (Health > 0.0f && (Health -= DamageTaken) <= 0.0f)
+	if (Health <= 0.0f)
 	{
-		const FVector Direction = ((GetActorLocation() - DamageCauser->GetActorLocation()).GetSafeNormal() + FVector::UpVector) * 0.5f;
+		const FVector CauserLocation = DamageCauser ? DamageCauser->GetActorLocation() : GetActorLocation() - GetActorForwardVector();
+		const FVector Direction = ((GetActorLocation() - CauserLocation).GetSafeNormal() + FVector::UpVector) * 0.5f;
 		CombatComponent->NetMultiServeFinalBlow(Direction);
 
+		OnDeath.Broadcast(this);
+
+		// Corpse moves to the low frequency replication list
+		if (UDodgerReplicationGraph* ReplicationGraph = UDodgerReplicationGraph::Get(this))
+		{
+			ReplicationGraph->UpdateCharacterRoute(this);
+		}
+
 		// leave body and allow free fly mode
 		if (APlayerController* PC = Cast<APlayerController>(GetController()))
 		{
 			PC->StartSpectatingOnly();	
 		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void ADodgerCharacter::DeactivateForPool(const FVector& PoolLocation)
+{
+	// Hidden without collision is not net relevant (nor routed by the replication graph) - clients drop the actor until it's reused
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+	HitValidationComponent->SetComponentTickEnabled(false);
+	TeleportTo(PoolLocation, GetActorRotation(), false, true);
+
+	// Pooled characters are not sensed by enemies
+	if (UStimulusManager* StimulusManager = UStimulusManager::Get(this))
+	{
+		StimulusManager->UnregisterSource(this);
+	}
+
+	if (UDodgerReplicationGraph* ReplicationGraph = UDodgerReplicationGraph::Get(this))
+	{
+		ReplicationGraph->UpdateCharacterRoute(this);
 	}
-	
-	return DamageTaken;
+}
+
+void ADodgerCharacter::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	// Corpse may have gone dormant before it was pooled
+	if (UDodgerDormancyManager* DormancyManager = UDodgerDormancyManager::Get(this))
+	{
+		DormancyManager->WakeCharacter(this);
+	}
+
+	Health = GetClass()->GetDefaultObject<ADodgerCharacter>()->Health;
+
+	TeleportTo(Location, Rotation, false, true);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	if (UStimulusManager* StimulusManager = UStimulusManager::Get(this))
+	{
+		StimulusManager->RegisterSource(this);
+	}
+
+	// Rewind history of the previous life must not be used for new hits
+	HitValidationComponent->ResetHistory();
+	HitValidationComponent->SetComponentTickEnabled(true);
+
+	// Undo ragdoll and combat state everywhere the actor still exists, replicates restored health too
+	CombatComponent->NetMultiResetCombat();
+
+	// Back to the spatial grid, the actor is relevant again
+	if (UDodgerReplicationGraph* ReplicationGraph = UDodgerReplicationGraph::Get(this))
+	{
+		ReplicationGraph->UpdateCharacterRoute(this);
+	}
+}
+
+void ADodgerCharacter::OnRep_LastDamageResult()
+{
+	OnDamageResult.Broadcast(this, LastDamageResult);
 }
 
 void ADodgerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -264,12 +421,26 @@ bool ADodgerCharacter::IsAttacking() const
 
 float ADodgerCharacter::GetHealth() const
 {
-	return Health;
+	return HasAuthority() ? Health : CombatComponent->GetReplicatedHealth();
 }
 
 void ADodgerCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ADodgerCharacter, Health);
-}
\ No newline at end of file
+	// Push model - only compared after being marked dirty where it's written, health replicates with combat state
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ADodgerCharacter, LastDamageResult, Params);
+}
+
+void ADodgerCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	if (UDodgerNetAccounting* NetAccounting = UDodgerNetAccounting::Get(this))
+	{
+		NetAccounting->RecordReplicatedProperties(this, this);
+		NetAccounting->RecordReplicatedProperties(this, CombatComponent);
+	}
+}
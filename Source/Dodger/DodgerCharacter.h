@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "DodgerNetTypes.h"
 #include "Interfaces/DodgerCombatInterface.h"
 #include "Logging/LogMacros.h"
 #include "DodgerCharacter.generated.h"
@@ -19,6 +20,9 @@ struct FInputActionValue;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
+using FOnDamageResultDelegate = TMulticastDelegate<void(ADodgerCharacter* Character, const FDodgerDamageResult& Result)>;
+using FOnCharacterDeathDelegate = TMulticastDelegate<void(ADodgerCharacter* Character)>;
+
 UCLASS(config=Game)
 class ADodgerCharacter : public ACharacter, public IDodgerCombatInterface
 {
@@ -43,6 +47,24 @@ public:
 	virtual bool IsInvulnerable() const override;
 	virtual float GetHealth() const override;
 	// IDodgerCombatInterface End
+
+	/**
+	 * Apply merged damage of one frame (server only, see UDamageManager)
+	 */
+	void ApplyResolvedDamage(FDodgerDamageResult Result, float Damage, AController* EventInstigator, AActor* DamageCauser);
+	/**
+	 * Fired on server and clients for every replicated damage result (hit reactions, hit markers)
+	 */
+	FOnDamageResultDelegate OnDamageResult;
+	/**
+	 * Fired on server when the character dies
+	 */
+	FOnCharacterDeathDelegate OnDeath;
+	/**
+	 * Pooling (server only, see UEnemySpawner) - park character out of play / bring it back fully reset
+	 */
+	void DeactivateForPool(const FVector& PoolLocation);
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
 	
 protected:
 	
@@ -55,13 +77,20 @@ protected:
 	
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual bool CanJumpInternal_Implementation() const override;
 	virtual float TakeDamage(float DamageAmount, const FDamageEvent& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 private:
 
 	void AddHitBox(UBoxComponent* HitBox);
+
+	// Reduce health, handles final blow. Returns true if this damage killed the character
+	bool ReduceHealth(float Damage, AActor* DamageCauser);
+
+	UFUNCTION()
+	void OnRep_LastDamageResult();
 	
 	/** Camera boom positioning the camera behind the character */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
@@ -110,9 +139,11 @@ private:
 	UPROPERTY()
 	TMap<FName, TObjectPtr<UBoxComponent>> HitBoxes;
 	
-	UPROPERTY(Replicated)
+	// Server only, clients read the quantized copy replicated by UDodgerCombatComponent
 	float Health = 100.0f;
 
-	double LastNoiseEmittedTime = 0.0;
+	// Compact summary of the last frame this character took damage
+	UPROPERTY(ReplicatedUsing = OnRep_LastDamageResult)
+	FDodgerDamageResult LastDamageResult;
 };
 
@@ -0,0 +1,164 @@
+
+#include "DodgerDormancyManager.h"
+
+#include "DodgerCharacter.h"
+#include "DodgerStressTimings.h"
+#include "EnemyAIController.h"
+#include "Components/DodgerCombatComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarNetDormancy(
+		TEXT("Dodger.Net.Dormancy"),
+		true,
+		TEXT("Put idle and dead characters not controlled by players to net dormancy."));
+
+	TAutoConsoleVariable<float> CVarNetDormancySettleTime(
+		TEXT("Dodger.Net.DormancySettleTime"),
+		1.0f,
+		TEXT("Seconds an idle character has to stay inactive before going dormant."));
+
+	TAutoConsoleVariable<float> CVarNetCorpseSettleTime(
+		TEXT("Dodger.Net.CorpseSettleTime"),
+		2.0f,
+		TEXT("Seconds after death before a corpse goes dormant, covers the final blow and its last movement updates."));
+
+	// Dormancy doesn't need to react within a frame, wake ups are explicit
+	constexpr double UpdateInterval = 0.5;
+
+	constexpr float MaxIdleSpeedSquared = 1.0f;
+}
+
+UDodgerDormancyManager* UDodgerDormancyManager::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UDodgerDormancyManager>();
+	}
+
+	return nullptr;
+}
+
+bool UDodgerDormancyManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDodgerDormancyManager::RegisterCharacter(ADodgerCharacter* Character)
+{
+	// Only the server replicates
+	if (!Character || GetWorld()->IsNetMode(NM_Client) || GetWorld()->IsNetMode(NM_Standalone))
+	{
+		return;
+	}
+
+	Characters.Add(TObjectKey<ADodgerCharacter>(Character), FEntry{Character});
+}
+
+void UDodgerDormancyManager::UnregisterCharacter(ADodgerCharacter* Character)
+{
+	Characters.Remove(TObjectKey<ADodgerCharacter>(Character));
+}
+
+void UDodgerDormancyManager::WakeCharacter(ADodgerCharacter* Character)
+{
+	FEntry* Entry = Characters.Find(TObjectKey<ADodgerCharacter>(Character));
+	if (!Entry)
+	{
+		return;
+	}
+
+	Entry->InactiveSince = -1.0;
+	if (Character->NetDormancy > DORM_Awake)
+	{
+		Character->SetNetDormancy(DORM_Awake);
+	}
+}
+
+void UDodgerDormancyManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DODGER_STRESS_TIMING_SCOPE("Dormancy");
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Characters.IsEmpty() || Now < NextUpdateTime)
+	{
+		return;
+	}
+	NextUpdateTime = Now + UpdateInterval;
+
+	for (TPair<TObjectKey<ADodgerCharacter>, FEntry>& Pair : Characters)
+	{
+		UpdateCharacter(Pair.Value, Now);
+	}
+}
+
+void UDodgerDormancyManager::UpdateCharacter(FEntry& Entry, double Now) const
+{
+	ADodgerCharacter* Character = Entry.Character.Get();
+	// Pooled characters are not replicated at all
+	if (!Character || Character->IsHidden())
+	{
+		return;
+	}
+
+	const bool bDormant = Character->NetDormancy > DORM_Awake;
+	if (!CVarNetDormancy.GetValueOnGameThread() || !IsInactive(Character))
+	{
+		// Moving without a state change (e.g. pushed), anything explicit already woke it
+		Entry.InactiveSince = -1.0;
+		if (bDormant)
+		{
+			Character->SetNetDormancy(DORM_Awake);
+		}
+		return;
+	}
+
+	if (Entry.InactiveSince < 0.0)
+	{
+		Entry.InactiveSince = Now;
+	}
+
+	const float SettleTime = Character->GetHealth() > 0.0f ? CVarNetDormancySettleTime.GetValueOnGameThread() : CVarNetCorpseSettleTime.GetValueOnGameThread();
+	if (!bDormant && Now - Entry.InactiveSince >= SettleTime)
+	{
+		Character->SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+bool UDodgerDormancyManager::IsInactive(const ADodgerCharacter* Character)
+{
+	// Players change their state all the time and their own connection needs the pawn anyway
+	const AController* Controller = Character->GetController();
+	if (Controller && Controller->IsPlayerController())
+	{
+		return false;
+	}
+
+	if (Character->GetVelocity().SizeSquared() > MaxIdleSpeedSquared)
+	{
+		return false;
+	}
+
+	const ECombatState CombatState = Character->GetCombat()->GetState();
+	if (CombatState == ECombatState::Dead)
+	{
+		return true;
+	}
+
+	if (CombatState != ECombatState::Idle)
+	{
+		return false;
+	}
+
+	// Enemies in Idle stand until they sense someone, other AI only has to be still
+	const AEnemyAIController* EnemyAI = Cast<AEnemyAIController>(Controller);
+	return !EnemyAI || EnemyAI->GetState() == EEnemyState::Idle;
+}
+
+TStatId UDodgerDormancyManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDodgerDormancyManager, STATGROUP_Tickables);
+}
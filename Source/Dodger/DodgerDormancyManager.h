@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DodgerDormancyManager.generated.h"
+
+class ADodgerCharacter;
+
+/**
+ * Puts inactive characters not controlled by players to net dormancy (server only). Characters standing
+ * in Idle or dead and settled for a while stop being considered for replication until they wake up on
+ * state transitions, damage, multicasts, movement or pool reuse (see UDodgerReplicationGraph).
+ */
+UCLASS()
+class DODGER_API UDodgerDormancyManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDodgerDormancyManager* Get(const UObject* WorldContext);
+	/**
+	 *  Start/stop managing character
+	 */
+	void RegisterCharacter(ADodgerCharacter* Character);
+	void UnregisterCharacter(ADodgerCharacter* Character);
+	/**
+	 *  Wake character before something it replicates changes, it may go dormant again after settling
+	 */
+	void WakeCharacter(ADodgerCharacter* Character);
+	
+	// Base Interface Start
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<ADodgerCharacter> Character;
+		// Time since the character has been inactive, negative while active
+		double InactiveSince = -1.0;
+	};
+
+	void UpdateCharacter(FEntry& Entry, double Now) const;
+	static bool IsInactive(const ADodgerCharacter* Character);
+	
+	TMap<TObjectKey<ADodgerCharacter>, FEntry> Characters;
+	
+	double NextUpdateTime = 0.0;
+};
@@ -4,6 +4,9 @@
 #include "DodgerCharacter.h"
 #include "DodgerHUD.h"
 #include "DodgerPlayerController.h"
+#include "DodgerStressTest.h"
+#include "EnemySpawner.h"
+#include "Data/EnemySpawnTable.h"
 #include "UObject/ConstructorHelpers.h"
 
 ADodgerGameMode::ADodgerGameMode()
@@ -19,3 +22,14 @@ ADodgerGameMode::ADodgerGameMode()
 	PlayerControllerClass = ADodgerPlayerController::StaticClass();
 	HUDClass = ADodgerHUD::StaticClass();
 }
+
+void ADodgerGameMode::StartPlay()
+{
+	Super::StartPlay();
+
+	// Stress test spawns its own enemies
+	if (SpawnTable && !UDodgerStressTest::IsRequested())
+	{
+		UEnemySpawner::Get(this)->StartWaves(SpawnTable);
+	}
+}
@@ -6,6 +6,8 @@
 #include "GameFramework/GameModeBase.h"
 #include "DodgerGameMode.generated.h"
 
+class UEnemySpawnTable;
+
 UCLASS(minimalapi)
 class ADodgerGameMode : public AGameModeBase
 {
@@ -13,6 +15,13 @@ class ADodgerGameMode : public AGameModeBase
 
 public:
 	ADodgerGameMode();
+
+	virtual void StartPlay() override;
+
+protected:
+	/** Enemy waves spawned during the match, no enemies are spawned when not set */
+	UPROPERTY(EditDefaultsOnly, Category = Enemies)
+	TObjectPtr<const UEnemySpawnTable> SpawnTable;
 };
 
 
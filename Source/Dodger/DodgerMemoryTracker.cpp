@@ -0,0 +1,173 @@
+
+#include "DodgerMemoryTracker.h"
+
+#include "DodgerCharacter.h"
+#include "EngineUtils.h"
+#include "EnemyAIController.h"
+#include "EnemyAIManager.h"
+#include "FlowFieldManager.h"
+#include "HitboxPoseCache.h"
+#include "Projectile.h"
+#include "ProjectileManager.h"
+#include "StimulusManager.h"
+#include "Components/HitValidationComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarMemSampleInterval(
+		TEXT("Dodger.Mem.SampleInterval"),
+		10.0f,
+		TEXT("Seconds between samples of Dodger memory usage (peaks are tracked at this rate), 0 disables sampling."));
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice MemReportCommand(
+		TEXT("Dodger.MemReport"),
+		TEXT("Print current and peak memory per Dodger system."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (UDodgerMemoryTracker* MemoryTracker = UDodgerMemoryTracker::Get(World))
+			{
+				MemoryTracker->Sample();
+				MemoryTracker->Dump(Ar);
+			}
+		}));
+
+	// Instance size of actor and its components, their own allocations are not included
+	SIZE_T GetActorInstanceSize(const AActor* Actor)
+	{
+		SIZE_T Size = Actor->GetClass()->GetStructureSize();
+		for (const UActorComponent* Component : Actor->GetComponents())
+		{
+			Size += Component ? Component->GetClass()->GetStructureSize() : 0;
+		}
+		return Size;
+	}
+}
+
+UDodgerMemoryTracker* UDodgerMemoryTracker::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UDodgerMemoryTracker>();
+	}
+
+	return nullptr;
+}
+
+bool UDodgerMemoryTracker::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDodgerMemoryTracker::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const float SampleInterval = CVarMemSampleInterval.GetValueOnGameThread();
+	const double Now = GetWorld()->GetRealTimeSeconds();
+	if (SampleInterval > 0.0f && Now >= NextSampleTime)
+	{
+		NextSampleTime = Now + SampleInterval;
+		Sample();
+	}
+}
+
+void UDodgerMemoryTracker::Sample()
+{
+	UWorld* World = GetWorld();
+
+	// Projectile pool - manager and all projectile actors, pooled or flying
+	{
+		SIZE_T Bytes = 0;
+		int32 Count = 0;
+		for (TActorIterator<AProjectile> It(World); It; ++It)
+		{
+			Bytes += GetActorInstanceSize(*It);
+			++Count;
+		}
+		if (const UProjectileManager* ProjectileManager = World->GetSubsystem<UProjectileManager>())
+		{
+			Bytes += ProjectileManager->GetAllocatedSize();
+		}
+		Update(TEXT("Projectiles"), Bytes, Count);
+	}
+
+	// Frame histories of hit validation and baked server hitbox poses
+	{
+		SIZE_T Bytes = 0;
+		int32 Count = 0;
+		for (TActorIterator<ADodgerCharacter> It(World); It; ++It)
+		{
+			if (const UHitValidationComponent* HitValidation = It->GetHitValidation())
+			{
+				Bytes += HitValidation->GetAllocatedSize();
+				++Count;
+			}
+		}
+		Update(TEXT("HitValidation"), Bytes, Count);
+
+		const UHitboxPoseCache* HitboxPoseCache = World->GetSubsystem<UHitboxPoseCache>();
+		Update(TEXT("HitboxPoses"), HitboxPoseCache ? HitboxPoseCache->GetAllocatedSize() : 0, 0);
+	}
+
+	// Enemy controllers and shared AI state
+	{
+		SIZE_T Bytes = 0;
+		int32 Count = 0;
+		for (TActorIterator<AEnemyAIController> It(World); It; ++It)
+		{
+			Bytes += GetActorInstanceSize(*It) + It->GetAllocatedSize();
+			++Count;
+		}
+		if (const UEnemyAIManager* AIManager = World->GetSubsystem<UEnemyAIManager>())
+		{
+			Bytes += AIManager->GetAllocatedSize();
+		}
+		Update(TEXT("AIControllers"), Bytes, Count);
+
+		const UFlowFieldManager* FlowFieldManager = World->GetSubsystem<UFlowFieldManager>();
+		Update(TEXT("FlowFields"), FlowFieldManager ? FlowFieldManager->GetAllocatedSize() : 0, 0);
+
+		const UStimulusManager* StimulusManager = World->GetSubsystem<UStimulusManager>();
+		Update(TEXT("Perception"), StimulusManager ? StimulusManager->GetAllocatedSize() : 0, 0);
+	}
+
+	// Dynamic materials (enemy tint fallback and any other MIDs created in this world)
+	{
+		SIZE_T Bytes = 0;
+		int32 Count = 0;
+		for (TObjectIterator<UMaterialInstanceDynamic> It; It; ++It)
+		{
+			if (It->GetWorld() == World)
+			{
+				Bytes += It->GetClass()->GetStructureSize() + It->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+				++Count;
+			}
+		}
+		Update(TEXT("DynamicMaterials"), Bytes, Count);
+	}
+}
+
+void UDodgerMemoryTracker::Update(FName System, SIZE_T Bytes, int32 Count)
+{
+	FUsage& Entry = Usage.FindOrAdd(System);
+	Entry.Current = Bytes;
+	Entry.Peak = FMath::Max(Entry.Peak, Bytes);
+	Entry.Count = Count;
+}
+
+void UDodgerMemoryTracker::Dump(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Dodger memory (%s)"), *GetWorld()->GetName());
+	Ar.Logf(TEXT("  %-20s %12s %12s %8s"), TEXT("System"), TEXT("CurrentKB"), TEXT("PeakKB"), TEXT("Count"));
+	for (const TPair<FName, FUsage>& Pair : Usage)
+	{
+		Ar.Logf(TEXT("  %-20s %12.1f %12.1f %8d"), *Pair.Key.ToString(), Pair.Value.Current / 1024.0, Pair.Value.Peak / 1024.0, Pair.Value.Count);
+	}
+}
+
+TStatId UDodgerMemoryTracker::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDodgerMemoryTracker, STATGROUP_Tickables);
+}
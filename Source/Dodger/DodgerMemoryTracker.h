@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DodgerMemoryTracker.generated.h"
+
+/**
+ * Current and peak memory per Dodger system, sampled every Dodger.Mem.SampleInterval seconds.
+ * Counts containers owned by the systems plus instance sizes of their actors and objects - complements
+ * LLM tags (Dodger/...) which need -llm. Dumped by Dodger.MemReport, also part of memreport output.
+ */
+UCLASS()
+class DODGER_API UDodgerMemoryTracker : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDodgerMemoryTracker* Get(const UObject* WorldContext);
+
+	void Sample();
+	void Dump(FOutputDevice& Ar) const;
+	
+	// Base Interface Start
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FUsage
+	{
+		SIZE_T Current = 0;
+		SIZE_T Peak = 0;
+		int32 Count = 0;
+	};
+
+	void Update(FName System, SIZE_T Bytes, int32 Count);
+	
+	TMap<FName, FUsage> Usage;
+
+	double NextSampleTime = 0.0;
+};
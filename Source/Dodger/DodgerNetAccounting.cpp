@@ -0,0 +1,358 @@
+
+#include "DodgerNetAccounting.h"
+
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/CoreNet.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarNetAccounting(
+		TEXT("Dodger.Net.Accounting"),
+		0,
+		TEXT("Count calls, bytes and drops of sent RPCs and replicated properties. Serializes every sent payload once more, leave off when not measuring."));
+
+	TAutoConsoleVariable<float> CVarNetAccountingCsvInterval(
+		TEXT("Dodger.Net.AccountingCsvInterval"),
+		10.0f,
+		TEXT("Seconds between writes of accumulated net accounting to CSV, 0 disables."));
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("Dodger.Net.Dump"),
+		TEXT("Print net accounting totals and per connection."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (const UDodgerNetAccounting* NetAccounting = UDodgerNetAccounting::Get(World))
+			{
+				NetAccounting->Dump(Ar);
+			}
+		}));
+
+	FAutoConsoleCommandWithWorld ResetCommand(
+		TEXT("Dodger.Net.Reset"),
+		TEXT("Clear net accounting."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (UDodgerNetAccounting* NetAccounting = UDodgerNetAccounting::Get(World))
+			{
+				NetAccounting->Reset();
+			}
+		}));
+
+	const FString TotalName(TEXT("Total"));
+
+	// Properties declared by this module, engine ones (movement, attachment) are left to net stats and Net Insights
+	bool IsAccountedProperty(const FProperty* Property)
+	{
+		const UClass* OwnerClass = Property->GetOwnerClass();
+		if (!OwnerClass || OwnerClass->GetOutermost() != UDodgerNetAccounting::StaticClass()->GetOutermost())
+		{
+			return false;
+		}
+
+		// Only structs with native NetSerialize can be serialized as one item, others go through the RepLayout
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			return (StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative) != 0;
+		}
+
+		return !Property->IsA<FArrayProperty>();
+	}
+
+	// Whether property with the condition is replicated to the connection
+	bool IsSentToConnection(ELifetimeCondition Condition, const AActor* Actor, const UNetConnection* Connection)
+	{
+		const bool bOwner = Actor->GetNetConnection() == Connection;
+		const bool bAutonomous = bOwner && Actor->GetRemoteRole() == ROLE_AutonomousProxy;
+
+		switch (Condition)
+		{
+		case COND_OwnerOnly:
+			return bOwner;
+		case COND_SkipOwner:
+			return !bOwner;
+		case COND_SimulatedOnly:
+		case COND_SimulatedOnlyNoReplay:
+		case COND_SimulatedOrPhysics:
+		case COND_SimulatedOrPhysicsNoReplay:
+			return !bAutonomous;
+		case COND_AutonomousOnly:
+			return bAutonomous;
+		case COND_InitialOrOwner:
+		case COND_ReplayOrOwner:
+			return bOwner;
+		case COND_ReplayOnly:
+		case COND_InitialOnly:
+		case COND_Never:
+			return false;
+		default:
+			return true;
+		}
+	}
+}
+
+UDodgerNetAccounting* UDodgerNetAccounting::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UDodgerNetAccounting>();
+	}
+
+	return nullptr;
+}
+
+bool UDodgerNetAccounting::IsEnabled()
+{
+	return CVarNetAccounting.GetValueOnGameThread() != 0;
+}
+
+bool UDodgerNetAccounting::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDodgerNetAccounting::RecordRemoteFunction(AActor* Actor, const UFunction* Function, const void* Parms)
+{
+	// Accounting follows actor channels, Iris replicates without them
+	const UNetDriver* NetDriver = Actor ? Actor->GetNetDriver() : nullptr;
+	if (!IsEnabled() || !NetDriver || NetDriver->IsUsingIrisReplication() || !Function)
+	{
+		return;
+	}
+
+	const bool bReliable = Function->HasAnyFunctionFlags(FUNC_NetReliable);
+	
+	if (Function->HasAnyFunctionFlags(FUNC_NetMulticast))
+	{
+		if (!Actor->HasAuthority())
+		{
+			return;
+		}
+
+		// Payload size hardly differs between connections - serialize once
+		int64 Bits = INDEX_NONE;
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			// No channel - actor not relevant to this connection, nothing is sent
+			if (!Connection || !Connection->FindActorChannelRef(Actor))
+			{
+				continue;
+			}
+			if (Bits == INDEX_NONE)
+			{
+				Bits = SerializeParms(Function, Parms, Connection->PackageMap);
+			}
+			
+			// Unreliable multicasts are skipped for saturated connections
+			const bool bDropped = !bReliable && !Connection->IsNetReady();
+			Record(Connection, Function->GetFName(), false, Bits, bDropped);
+		}
+	}
+	else if (UNetConnection* Connection = Actor->GetNetConnection())
+	{
+		const bool bDropped = !bReliable && !Connection->IsNetReady();
+		Record(Connection, Function->GetFName(), false, SerializeParms(Function, Parms, Connection->PackageMap), bDropped);
+	}
+}
+
+void UDodgerNetAccounting::RecordReplicatedProperties(AActor* Actor, const UObject* Object)
+{
+	const UNetDriver* NetDriver = Actor ? Actor->GetNetDriver() : nullptr;
+	if (!IsEnabled() || !NetDriver || NetDriver->IsUsingIrisReplication() || NetDriver->ClientConnections.IsEmpty() || !Object)
+	{
+		return;
+	}
+
+	UClass* Class = Object->GetClass();
+	TArray<FLifetimeProperty>* Properties = LifetimeProperties.Find(TObjectKey<UClass>(Class));
+	if (!Properties)
+	{
+		Properties = &LifetimeProperties.Add(TObjectKey<UClass>(Class));
+		Object->GetLifetimeReplicatedProps(*Properties);
+	}
+
+	TArray<TArray<uint8>>& Shadows = PropertyShadows.FindOrAdd(TObjectKey<UObject>(Object));
+	Shadows.SetNum(Properties->Num());
+
+	UPackageMap* PackageMap = NetDriver->ClientConnections[0]->PackageMap;
+	for (int32 Index = 0; Index < Properties->Num(); ++Index)
+	{
+		const FLifetimeProperty& LifetimeProperty = (*Properties)[Index];
+		
+		// Initial only properties are part of channel open, not of updates
+		if (LifetimeProperty.Condition == COND_InitialOnly || LifetimeProperty.Condition == COND_Never)
+		{
+			continue;
+		}
+
+		const FRepRecord& Rep = Class->ClassReps[LifetimeProperty.RepIndex];
+		if (!IsAccountedProperty(Rep.Property))
+		{
+			continue;
+		}
+		FNetBitWriter Writer(PackageMap, 0);
+		Rep.Property->NetSerializeItem(Writer, PackageMap, const_cast<void*>(Rep.Property->ContainerPtrToValuePtr<void>(Object, Rep.Index)));
+
+		TArray<uint8>& Shadow = Shadows[Index];
+		if (Shadow == *Writer.GetBuffer())
+		{
+			continue;
+		}
+		Shadow = *Writer.GetBuffer();
+
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (Connection && Connection->FindActorChannelRef(Actor) && IsSentToConnection(LifetimeProperty.Condition, Actor, Connection))
+			{
+				Record(Connection, Rep.Property->GetFName(), true, Writer.GetNumBits(), false);
+			}
+		}
+	}
+}
+
+void UDodgerNetAccounting::Record(UNetConnection* Connection, FName Name, bool bProperty, int64 Bits, bool bDropped)
+{
+	auto Add = [Bits, bProperty, bDropped](FEntry& Entry)
+	{
+		++Entry.Calls;
+		Entry.Bits += Bits;
+		Entry.Drops += bDropped ? 1 : 0;
+		Entry.bProperty = bProperty;
+	};
+
+	Add(Totals.FindOrAdd(Name));
+
+	FConnectionEntries& ConnectionEntries = Connections.FindOrAdd(TObjectKey<UNetConnection>(Connection));
+	if (ConnectionEntries.Name.IsEmpty())
+	{
+		ConnectionEntries.Name = DescribeConnection(Connection);
+	}
+	Add(ConnectionEntries.Entries.FindOrAdd(Name));
+}
+
+int64 UDodgerNetAccounting::SerializeParms(const UFunction* Function, const void* Parms, UPackageMap* PackageMap)
+{
+	FNetBitWriter Writer(PackageMap, 0);
+	for (TFieldIterator<FProperty> It(Function); It && (It->PropertyFlags & (CPF_Parm | CPF_ReturnParm)) == CPF_Parm; ++It)
+	{
+		for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+		{
+			It->NetSerializeItem(Writer, PackageMap, const_cast<void*>(It->ContainerPtrToValuePtr<void>(Parms, Index)));
+		}
+	}
+	return Writer.GetNumBits();
+}
+
+FString UDodgerNetAccounting::DescribeConnection(UNetConnection* Connection)
+{
+	if (Connection->Driver && Connection->Driver->ServerConnection == Connection)
+	{
+		return TEXT("Server");
+	}
+	return Connection->LowLevelGetRemoteAddress(true);
+}
+
+void UDodgerNetAccounting::Dump(FOutputDevice& Ar) const
+{
+	auto DumpEntries = [&Ar](const FString& Title, const TMap<FName, FEntry>& Entries)
+	{
+		TArray<TPair<FName, FEntry>> Sorted = Entries.Array();
+		Sorted.Sort([](const TPair<FName, FEntry>& A, const TPair<FName, FEntry>& B) { return A.Value.Bits > B.Value.Bits; });
+
+		Ar.Logf(TEXT("%s"), *Title);
+		Ar.Logf(TEXT("  %-32s %-8s %10s %12s %10s %8s"), TEXT("Name"), TEXT("Kind"), TEXT("Calls"), TEXT("KBytes"), TEXT("Bytes/Call"), TEXT("Drops"));
+		for (const TPair<FName, FEntry>& Pair : Sorted)
+		{
+			const FEntry& Entry = Pair.Value;
+			Ar.Logf(TEXT("  %-32s %-8s %10lld %12.2f %10.1f %8lld"), *Pair.Key.ToString(), Entry.bProperty ? TEXT("Property") : TEXT("RPC"),
+				Entry.Calls, Entry.Bits / 8192.0, Entry.Calls > 0 ? Entry.Bits / 8.0 / Entry.Calls : 0.0, Entry.Drops);
+		}
+	};
+
+	DumpEntries(TotalName, Totals);
+	for (const TPair<TObjectKey<UNetConnection>, FConnectionEntries>& Pair : Connections)
+	{
+		DumpEntries(Pair.Value.Name, Pair.Value.Entries);
+	}
+}
+
+void UDodgerNetAccounting::Reset()
+{
+	Totals.Reset();
+	Connections.Reset();
+	PropertyShadows.Reset();
+}
+
+void UDodgerNetAccounting::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const float CsvInterval = CVarNetAccountingCsvInterval.GetValueOnGameThread();
+	if (!IsEnabled() || CsvInterval <= 0.0f)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetRealTimeSeconds();
+	if (Now < NextCsvTime)
+	{
+		return;
+	}
+	NextCsvTime = Now + CsvInterval;
+
+	WriteCsv();
+
+	// Forget destroyed objects
+	for (auto It = PropertyShadows.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UDodgerNetAccounting::WriteCsv()
+{
+	if (Totals.IsEmpty())
+	{
+		return;
+	}
+
+	// Rows are accumulated values, rates come from differences between writes
+	TArray<FString> Lines;
+	if (CsvFileName.IsEmpty())
+	{
+		const FString Directory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("NetAccounting"));
+		IFileManager::Get().MakeDirectory(*Directory, true);
+		const TCHAR* Role = GetWorld()->GetNetMode() == NM_Client ? TEXT("Client") : TEXT("Server");
+		CsvFileName = FPaths::Combine(Directory, FString::Printf(TEXT("NetAccounting-%s-%u-%s.csv"), Role, FPlatformProcess::GetCurrentProcessId(), *FDateTime::Now().ToString()));
+		Lines.Add(TEXT("Time,Connection,Name,Kind,Calls,Bytes,Drops"));
+	}
+
+	const double Now = GetWorld()->GetRealTimeSeconds();
+	auto AddLines = [&Lines, Now](const FString& Connection, const TMap<FName, FEntry>& Entries)
+	{
+		for (const TPair<FName, FEntry>& Pair : Entries)
+		{
+			Lines.Add(FString::Printf(TEXT("%.1f,%s,%s,%s,%lld,%lld,%lld"), Now, *Connection, *Pair.Key.ToString(),
+				Pair.Value.bProperty ? TEXT("Property") : TEXT("RPC"), Pair.Value.Calls, (Pair.Value.Bits + 7) / 8, Pair.Value.Drops));
+		}
+	};
+
+	AddLines(TotalName, Totals);
+	for (const TPair<TObjectKey<UNetConnection>, FConnectionEntries>& Pair : Connections)
+	{
+		AddLines(Pair.Value.Name, Pair.Value.Entries);
+	}
+
+	FFileHelper::SaveStringArrayToFile(Lines, *CsvFileName, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
+
+TStatId UDodgerNetAccounting::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDodgerNetAccounting, STATGROUP_Tickables);
+}
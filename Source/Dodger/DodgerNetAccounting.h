@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/UnrealNetwork.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DodgerNetAccounting.generated.h"
+
+class UNetConnection;
+class UPackageMap;
+
+/**
+ * Counts calls, payload bytes and drops of RPCs and replicated properties sent by this process,
+ * per connection and in total (enabled with Dodger.Net.Accounting 1).
+ * RPCs are recorded when called (see CallRemoteFunction overrides), property changes when the actor is
+ * considered for replication (see PreReplication overrides). Sizes are serialized payloads without packet/bunch headers.
+ * Dumped by Dodger.Net.Dump, written periodically to Saved/Profiling/NetAccounting as CSV.
+ * Legacy replication only, nothing is recorded when the net driver replicates with Iris.
+ */
+UCLASS()
+class DODGER_API UDodgerNetAccounting : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDodgerNetAccounting* Get(const UObject* WorldContext);
+	static bool IsEnabled();
+	/**
+	 * Record RPC sent by an actor or its component, call before Super::CallRemoteFunction
+	 */
+	void RecordRemoteFunction(AActor* Actor, const UFunction* Function, const void* Parms);
+	/**
+	 * Record replicated properties of the object (actor or its component) changed since the last call.
+	 * Only properties declared by Dodger classes are accounted, attributed to connections by their rep condition.
+	 */
+	void RecordReplicatedProperties(AActor* Actor, const UObject* Object);
+
+	void Dump(FOutputDevice& Ar) const;
+	void Reset();
+	
+	// Base Interface Start
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	
+private:
+	struct FEntry
+	{
+		int64 Calls = 0;
+		int64 Bits = 0;
+		int64 Drops = 0;
+		bool bProperty = false;
+	};
+
+	struct FConnectionEntries
+	{
+		FString Name;
+		TMap<FName, FEntry> Entries;
+	};
+	
+	void Record(UNetConnection* Connection, FName Name, bool bProperty, int64 Bits, bool bDropped);
+	void WriteCsv();
+	static int64 SerializeParms(const UFunction* Function, const void* Parms, UPackageMap* PackageMap);
+	static FString DescribeConnection(UNetConnection* Connection);
+	
+	TMap<FName, FEntry> Totals;
+	TMap<TObjectKey<UNetConnection>, FConnectionEntries> Connections;
+
+	// Last serialized value of each replicated property of an object, to detect changes
+	TMap<TObjectKey<UObject>, TArray<TArray<uint8>>> PropertyShadows;
+	TMap<TObjectKey<UClass>, TArray<FLifetimeProperty>> LifetimeProperties;
+	
+	FString CsvFileName;
+	double NextCsvTime = 0.0;
+};
@@ -0,0 +1,584 @@
+
+#include "DodgerNetTypes.h"
+
+#include "Engine/NetSerialization.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if UE_WITH_IRIS
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializer.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+#endif
+
+namespace
+{
+	enum ECombatRepField : uint8
+	{
+		Field_Health = 1 << 0,
+		Field_State = 1 << 1,
+		Field_Invulnerable = 1 << 2,
+		Field_MontageStart = 1 << 3,
+		Field_All = Field_Health | Field_State | Field_Invulnerable | Field_MontageStart
+	};
+	constexpr int64 NumFieldBits = 4;
+
+	// ECombatState fits two bits
+	constexpr int64 NumStateBits = 2;
+	static_assert(static_cast<uint8>(ECombatState::Dead) < (1 << NumStateBits));
+
+	// Combat state last sent to a connection, base of the next delta (kept by the replicator until acked)
+	class FDodgerCombatRepBaseState : public INetDeltaBaseState
+	{
+	public:
+		explicit FDodgerCombatRepBaseState(const FDodgerCombatRepState& InState) : State(InState) {}
+
+		virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+		{
+			return State == static_cast<const FDodgerCombatRepBaseState*>(OtherState)->State;
+		}
+
+		FDodgerCombatRepState State;
+	};
+}
+
+void FDodgerQuantizedAim::SetDirection(const FVector& Direction)
+{
+	const FRotator Rotation = Direction.GetSafeNormal().Rotation();
+	Yaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+	Pitch = FRotator::CompressAxisToShort(Rotation.Pitch);
+}
+
+FVector FDodgerQuantizedAim::GetDirection() const
+{
+	const FRotator Rotation(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw), 0.0);
+	return Rotation.Vector();
+}
+
+bool FDodgerQuantizedAim::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << Yaw;
+	Ar << Pitch;
+	bOutSuccess = true;
+	return true;
+}
+
+bool FDodgerAttackCommand::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << Sequence;
+	Ar << ClientTimestamp;
+	Aim.NetSerialize(Ar, Map, bOutSuccess);
+	return true;
+}
+
+bool FDodgerDamageResult::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << QuantizedDamage;
+	Ar << HitCount;
+	Ar << Serial;
+
+	uint8 Flags = (bHeadshot ? 1 : 0) | (bFatal ? 2 : 0);
+	Ar.SerializeBits(&Flags, 2);
+	bHeadshot = (Flags & 1) != 0;
+	bFatal = (Flags & 2) != 0;
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FDodgerCombatRepState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	SerializeFields(Ar, Field_All);
+	bOutSuccess = true;
+	return true;
+}
+
+bool FDodgerCombatRepState::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	if (DeltaParms.Writer)
+	{
+		// No base state on first send to the connection - everything goes
+		uint8 FieldMask = Field_All;
+		if (const FDodgerCombatRepBaseState* OldState = static_cast<const FDodgerCombatRepBaseState*>(DeltaParms.OldState))
+		{
+			const FDodgerCombatRepState& Old = OldState->State;
+			FieldMask = (QuantizedHealth != Old.QuantizedHealth ? Field_Health : 0)
+				| (State != Old.State ? Field_State : 0)
+				| (bInvulnerable != Old.bInvulnerable ? Field_Invulnerable : 0)
+				| (MontageStartTick != Old.MontageStartTick ? Field_MontageStart : 0);
+
+			if (FieldMask == 0)
+			{
+				return false;
+			}
+		}
+
+		DeltaParms.Writer->SerializeBits(&FieldMask, NumFieldBits);
+		SerializeFields(*DeltaParms.Writer, FieldMask);
+		*DeltaParms.NewState = MakeShared<FDodgerCombatRepBaseState>(*this);
+		return true;
+	}
+
+	if (DeltaParms.Reader)
+	{
+		uint8 FieldMask = 0;
+		DeltaParms.Reader->SerializeBits(&FieldMask, NumFieldBits);
+		SerializeFields(*DeltaParms.Reader, FieldMask);
+		return !DeltaParms.Reader->IsError();
+	}
+
+	// Nothing to gather or remap, the state has no object references
+	return true;
+}
+
+void FDodgerCombatRepState::SerializeFields(FArchive& Ar, uint8 FieldMask)
+{
+	if (FieldMask & Field_Health)
+	{
+		Ar << QuantizedHealth;
+	}
+
+	if (FieldMask & Field_State)
+	{
+		uint8 StateBits = static_cast<uint8>(State);
+		Ar.SerializeBits(&StateBits, NumStateBits);
+		State = static_cast<ECombatState>(StateBits);
+	}
+
+	if (FieldMask & Field_Invulnerable)
+	{
+		uint8 InvulnerableBit = bInvulnerable ? 1 : 0;
+		Ar.SerializeBits(&InvulnerableBit, 1);
+		bInvulnerable = InvulnerableBit != 0;
+	}
+
+	if (FieldMask & Field_MontageStart)
+	{
+		Ar.SerializeIntPacked(MontageStartTick);
+	}
+}
+
+#if UE_WITH_IRIS
+
+// Iris does not call NetSerialize / NetDeltaSerialize of structs, it quantizes replicated state and RPC parameters
+// once and serializes them per connection from worker threads. Serializers below produce the same bits as the
+// legacy ones (field masks, bit widths and the packed montage tick), so the module runs under either replication
+// system. Combat state deltas are taken against the baseline acked by the connection, which Iris keeps on its own.
+namespace UE::Net
+{
+	struct FDodgerQuantizedAimNetSerializer
+	{
+		static constexpr uint32 Version = 0;
+
+		// Yaw in low, pitch in high 16 bits
+		typedef FDodgerQuantizedAim SourceType;
+		typedef uint32 QuantizedType;
+		typedef FNetSerializerConfig ConfigType;
+
+		inline static const ConfigType DefaultConfig = ConfigType();
+
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+		{
+			Context.GetBitStreamWriter()->WriteBits(*reinterpret_cast<const QuantizedType*>(Args.Source), 32);
+		}
+
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+		{
+			*reinterpret_cast<QuantizedType*>(Args.Target) = Context.GetBitStreamReader()->ReadBits(32);
+		}
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+		{
+			const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+			*reinterpret_cast<QuantizedType*>(Args.Target) = Source.Yaw | (static_cast<uint32>(Source.Pitch) << 16);
+		}
+
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+		{
+			const QuantizedType Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+			Target.Yaw = static_cast<uint16>(Source);
+			Target.Pitch = static_cast<uint16>(Source >> 16);
+		}
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+		{
+			if (Args.bStateIsQuantized)
+			{
+				return *reinterpret_cast<const QuantizedType*>(Args.Source0) == *reinterpret_cast<const QuantizedType*>(Args.Source1);
+			}
+
+			const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+			const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+			return Value0.Yaw == Value1.Yaw && Value0.Pitch == Value1.Pitch;
+		}
+
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+		{
+			return true;
+		}
+	};
+	UE_NET_DECLARE_SERIALIZER(FDodgerQuantizedAimNetSerializer, DODGER_API);
+	UE_NET_IMPLEMENT_SERIALIZER(FDodgerQuantizedAimNetSerializer);
+
+	struct FDodgerAttackCommandNetSerializer
+	{
+		static constexpr uint32 Version = 0;
+
+		struct FQuantizedAttackCommand
+		{
+			uint32 Aim;
+			uint32 ClientTimestampBits;
+			uint32 Sequence;
+		};
+
+		typedef FDodgerAttackCommand SourceType;
+		typedef FQuantizedAttackCommand QuantizedType;
+		typedef FNetSerializerConfig ConfigType;
+
+		inline static const ConfigType DefaultConfig = ConfigType();
+
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+		{
+			const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+			Writer->WriteBits(Value.Sequence, 16);
+			Writer->WriteBits(Value.ClientTimestampBits, 32);
+			Writer->WriteBits(Value.Aim, 32);
+		}
+
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+		{
+			QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+			FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+			Target.Sequence = Reader->ReadBits(16);
+			Target.ClientTimestampBits = Reader->ReadBits(32);
+			Target.Aim = Reader->ReadBits(32);
+		}
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+		{
+			const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+			QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+			Target.Aim = Source.Aim.Yaw | (static_cast<uint32>(Source.Aim.Pitch) << 16);
+			FMemory::Memcpy(&Target.ClientTimestampBits, &Source.ClientTimestamp, sizeof(uint32));
+			Target.Sequence = Source.Sequence;
+		}
+
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+		{
+			const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+			Target.Aim.Yaw = static_cast<uint16>(Source.Aim);
+			Target.Aim.Pitch = static_cast<uint16>(Source.Aim >> 16);
+			FMemory::Memcpy(&Target.ClientTimestamp, &Source.ClientTimestampBits, sizeof(uint32));
+			Target.Sequence = static_cast<uint16>(Source.Sequence);
+		}
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+		{
+			if (Args.bStateIsQuantized)
+			{
+				const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+				const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+				return Value0.Aim == Value1.Aim && Value0.ClientTimestampBits == Value1.ClientTimestampBits && Value0.Sequence == Value1.Sequence;
+			}
+
+			const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+			const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+			return Value0.Sequence == Value1.Sequence && Value0.ClientTimestamp == Value1.ClientTimestamp
+				&& Value0.Aim.Yaw == Value1.Aim.Yaw && Value0.Aim.Pitch == Value1.Aim.Pitch;
+		}
+
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+		{
+			return FMath::IsFinite(reinterpret_cast<const SourceType*>(Args.Source)->ClientTimestamp);
+		}
+	};
+	UE_NET_DECLARE_SERIALIZER(FDodgerAttackCommandNetSerializer, DODGER_API);
+	UE_NET_IMPLEMENT_SERIALIZER(FDodgerAttackCommandNetSerializer);
+
+	struct FDodgerDamageResultNetSerializer
+	{
+		static constexpr uint32 Version = 0;
+
+		struct FQuantizedDamageResult
+		{
+			uint16 QuantizedDamage;
+			uint8 HitCount;
+			uint8 Serial;
+			// Headshot in bit 0, fatal in bit 1
+			uint32 Flags;
+		};
+
+		typedef FDodgerDamageResult SourceType;
+		typedef FQuantizedDamageResult QuantizedType;
+		typedef FNetSerializerConfig ConfigType;
+
+		inline static const ConfigType DefaultConfig = ConfigType();
+
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+		{
+			const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+			Writer->WriteBits(Value.QuantizedDamage, 16);
+			Writer->WriteBits(Value.HitCount, 8);
+			Writer->WriteBits(Value.Serial, 8);
+			Writer->WriteBits(Value.Flags, 2);
+		}
+
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+		{
+			QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+			FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+			Target.QuantizedDamage = static_cast<uint16>(Reader->ReadBits(16));
+			Target.HitCount = static_cast<uint8>(Reader->ReadBits(8));
+			Target.Serial = static_cast<uint8>(Reader->ReadBits(8));
+			Target.Flags = Reader->ReadBits(2);
+		}
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+		{
+			const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+			QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+			Target.QuantizedDamage = Source.QuantizedDamage;
+			Target.HitCount = Source.HitCount;
+			Target.Serial = Source.Serial;
+			Target.Flags = (Source.bHeadshot ? 1 : 0) | (Source.bFatal ? 2 : 0);
+		}
+
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+		{
+			const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+			Target.QuantizedDamage = Source.QuantizedDamage;
+			Target.HitCount = Source.HitCount;
+			Target.Serial = Source.Serial;
+			Target.bHeadshot = (Source.Flags & 1) != 0;
+			Target.bFatal = (Source.Flags & 2) != 0;
+		}
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+		{
+			if (Args.bStateIsQuantized)
+			{
+				const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+				const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+				return Value0.QuantizedDamage == Value1.QuantizedDamage && Value0.HitCount == Value1.HitCount
+					&& Value0.Serial == Value1.Serial && Value0.Flags == Value1.Flags;
+			}
+
+			const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+			const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+			return Value0.QuantizedDamage == Value1.QuantizedDamage && Value0.HitCount == Value1.HitCount
+				&& Value0.Serial == Value1.Serial && Value0.bHeadshot == Value1.bHeadshot && Value0.bFatal == Value1.bFatal;
+		}
+
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+		{
+			return true;
+		}
+	};
+	UE_NET_DECLARE_SERIALIZER(FDodgerDamageResultNetSerializer, DODGER_API);
+	UE_NET_IMPLEMENT_SERIALIZER(FDodgerDamageResultNetSerializer);
+
+	struct FDodgerCombatRepStateNetSerializer
+	{
+		static constexpr uint32 Version = 0;
+
+		// Delta against the acked baseline is written by SerializeDelta below
+		static constexpr bool bUseDefaultDelta = false;
+
+		struct FQuantizedCombatRepState
+		{
+			uint32 MontageStartTick;
+			uint16 QuantizedHealth;
+			uint8 State;
+			uint8 bInvulnerable;
+		};
+
+		typedef FDodgerCombatRepState SourceType;
+		typedef FQuantizedCombatRepState QuantizedType;
+		typedef FNetSerializerConfig ConfigType;
+
+		inline static const ConfigType DefaultConfig = ConfigType();
+
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+		{
+			WriteFields(*Context.GetBitStreamWriter(), *reinterpret_cast<const QuantizedType*>(Args.Source), Field_All);
+		}
+
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+		{
+			ReadFields(*Context.GetBitStreamReader(), *reinterpret_cast<QuantizedType*>(Args.Target), Field_All);
+		}
+
+		static void SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args)
+		{
+			const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			const QuantizedType& Prev = *reinterpret_cast<const QuantizedType*>(Args.Prev);
+			const uint32 FieldMask = (Value.QuantizedHealth != Prev.QuantizedHealth ? Field_Health : 0)
+				| (Value.State != Prev.State ? Field_State : 0)
+				| (Value.bInvulnerable != Prev.bInvulnerable ? Field_Invulnerable : 0)
+				| (Value.MontageStartTick != Prev.MontageStartTick ? Field_MontageStart : 0);
+
+			FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+			Writer->WriteBits(FieldMask, NumFieldBits);
+			WriteFields(*Writer, Value, FieldMask);
+		}
+
+		static void DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args)
+		{
+			QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+			Target = *reinterpret_cast<const QuantizedType*>(Args.Prev);
+
+			FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+			const uint32 FieldMask = Reader->ReadBits(NumFieldBits);
+			ReadFields(*Reader, Target, FieldMask);
+		}
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+		{
+			const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+			QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+			Target.MontageStartTick = Source.MontageStartTick;
+			Target.QuantizedHealth = Source.QuantizedHealth;
+			Target.State = static_cast<uint8>(Source.State);
+			Target.bInvulnerable = Source.bInvulnerable ? 1 : 0;
+		}
+
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+		{
+			const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+			Target.MontageStartTick = Source.MontageStartTick;
+			Target.QuantizedHealth = Source.QuantizedHealth;
+			Target.State = static_cast<ECombatState>(Source.State);
+			Target.bInvulnerable = Source.bInvulnerable != 0;
+		}
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+		{
+			if (Args.bStateIsQuantized)
+			{
+				const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+				const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+				return Value0.MontageStartTick == Value1.MontageStartTick && Value0.QuantizedHealth == Value1.QuantizedHealth
+					&& Value0.State == Value1.State && Value0.bInvulnerable == Value1.bInvulnerable;
+			}
+
+			return *reinterpret_cast<const SourceType*>(Args.Source0) == *reinterpret_cast<const SourceType*>(Args.Source1);
+		}
+
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+		{
+			return static_cast<uint8>(reinterpret_cast<const SourceType*>(Args.Source)->State) < (1 << NumStateBits);
+		}
+
+	private:
+		static void WriteFields(FNetBitStreamWriter& Writer, const QuantizedType& Value, uint32 FieldMask)
+		{
+			if (FieldMask & Field_Health)
+			{
+				Writer.WriteBits(Value.QuantizedHealth, 16);
+			}
+			if (FieldMask & Field_State)
+			{
+				Writer.WriteBits(Value.State, NumStateBits);
+			}
+			if (FieldMask & Field_Invulnerable)
+			{
+				Writer.WriteBool(Value.bInvulnerable != 0);
+			}
+			if (FieldMask & Field_MontageStart)
+			{
+				WritePackedTick(Writer, Value.MontageStartTick);
+			}
+		}
+
+		// Same encoding as FArchive::SerializeIntPacked of the legacy path - 7 bit groups with a continuation bit
+		static void WritePackedTick(FNetBitStreamWriter& Writer, uint32 Value)
+		{
+			do
+			{
+				const uint32 bMore = (Value & ~0x7Fu) != 0 ? 1 : 0;
+				Writer.WriteBits(((Value & 0x7Fu) << 1) | bMore, 8);
+				Value >>= 7;
+			}
+			while (Value != 0);
+		}
+
+		static uint32 ReadPackedTick(FNetBitStreamReader& Reader)
+		{
+			uint32 Value = 0;
+			for (uint32 Shift = 0; Shift < 32; Shift += 7)
+			{
+				const uint32 Byte = Reader.ReadBits(8);
+				Value |= (Byte >> 1) << Shift;
+				if ((Byte & 1) == 0)
+				{
+					break;
+				}
+			}
+			return Value;
+		}
+
+		static void ReadFields(FNetBitStreamReader& Reader, QuantizedType& Target, uint32 FieldMask)
+		{
+			if (FieldMask & Field_Health)
+			{
+				Target.QuantizedHealth = static_cast<uint16>(Reader.ReadBits(16));
+			}
+			if (FieldMask & Field_State)
+			{
+				Target.State = static_cast<uint8>(Reader.ReadBits(NumStateBits));
+			}
+			if (FieldMask & Field_Invulnerable)
+			{
+				Target.bInvulnerable = Reader.ReadBool() ? 1 : 0;
+			}
+			if (FieldMask & Field_MontageStart)
+			{
+				Target.MontageStartTick = ReadPackedTick(Reader);
+			}
+		}
+	};
+	UE_NET_DECLARE_SERIALIZER(FDodgerCombatRepStateNetSerializer, DODGER_API);
+	UE_NET_IMPLEMENT_SERIALIZER(FDodgerCombatRepStateNetSerializer);
+
+	// Iris looks up serializers of structs by name, registered before the serializer registry freezes
+	static const FName PropertyNetSerializerRegistry_NAME_DodgerQuantizedAim("DodgerQuantizedAim");
+	static const FName PropertyNetSerializerRegistry_NAME_DodgerAttackCommand("DodgerAttackCommand");
+	static const FName PropertyNetSerializerRegistry_NAME_DodgerDamageResult("DodgerDamageResult");
+	static const FName PropertyNetSerializerRegistry_NAME_DodgerCombatRepState("DodgerCombatRepState");
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerQuantizedAim, FDodgerQuantizedAimNetSerializer);
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerAttackCommand, FDodgerAttackCommandNetSerializer);
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerDamageResult, FDodgerDamageResultNetSerializer);
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerCombatRepState, FDodgerCombatRepStateNetSerializer);
+
+	class FDodgerNetSerializerRegistryDelegates final : private FNetSerializerRegistryDelegates
+	{
+	public:
+		virtual ~FDodgerNetSerializerRegistryDelegates() override
+		{
+			UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerQuantizedAim);
+			UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerAttackCommand);
+			UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerDamageResult);
+			UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerCombatRepState);
+		}
+
+	private:
+		virtual void OnPreFreezeNetSerializerRegistry() override
+		{
+			UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerQuantizedAim);
+			UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerAttackCommand);
+			UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerDamageResult);
+			UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_DodgerCombatRepState);
+		}
+	};
+	static FDodgerNetSerializerRegistryDelegates DodgerNetSerializerRegistryDelegates;
+}
+
+#endif // UE_WITH_IRIS
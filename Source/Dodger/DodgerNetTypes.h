@@ -0,0 +1,170 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DodgerNetTypes.generated.h"
+
+struct FNetDeltaSerializeInfo;
+
+UENUM()
+enum class ECombatState : uint8
+{
+	Idle,
+	Attack,
+	Dodge,
+	Dead
+};
+
+/**
+ * Aim direction compressed to 16 bit yaw and pitch (~0.0055 degree precision).
+ */
+USTRUCT()
+struct DODGER_API FDodgerQuantizedAim
+{
+	GENERATED_BODY()
+
+	uint16 Yaw = 0;
+
+	uint16 Pitch = 0;
+
+	void SetDirection(const FVector& Direction);
+
+	FVector GetDirection() const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FDodgerQuantizedAim> : public TStructOpsTypeTraitsBase2<FDodgerQuantizedAim>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Everything the server needs to replay an attack: sent once per attack instead of separate
+ * attack and fire RPCs.
+ */
+USTRUCT()
+struct DODGER_API FDodgerAttackCommand
+{
+	GENERATED_BODY()
+
+	// Increments with every attack, rejects duplicated and reordered commands
+	uint16 Sequence = 0;
+
+	// Client estimate of server time when the attack started
+	float ClientTimestamp = 0.0f;
+
+	FDodgerQuantizedAim Aim;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	// Sequence comparison tolerant to wrap around
+	static bool IsSequenceNewer(uint16 Sequence, uint16 Than) { return static_cast<int16>(Sequence - Than) > 0; }
+};
+
+template<>
+struct TStructOpsTypeTraits<FDodgerAttackCommand> : public TStructOpsTypeTraitsBase2<FDodgerAttackCommand>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Merged outcome of all hits a character received in one frame.
+ */
+USTRUCT()
+struct DODGER_API FDodgerDamageResult
+{
+	GENERATED_BODY()
+
+	// Total damage in tenths of health point
+	uint16 QuantizedDamage = 0;
+
+	// Number of merged hits
+	uint8 HitCount = 0;
+
+	// Bumped on every result so equal consecutive results still replicate
+	uint8 Serial = 0;
+
+	bool bHeadshot = false;
+
+	bool bFatal = false;
+
+	void SetDamage(float Damage) { QuantizedDamage = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Damage * 10.0f), 0, MAX_uint16)); }
+
+	float GetDamage() const { return QuantizedDamage * 0.1f; }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FDodgerDamageResult> : public TStructOpsTypeTraitsBase2<FDodgerDamageResult>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Replicated combat state of a character in one property - quantized health, combat state, invulnerability
+ * and montage start tick. Delta serialized against the state last acked by the connection, unchanged fields
+ * cost one bit each and unchanged state is not compared field by field nor sent at all.
+ * Under Iris the same layout is written by FDodgerCombatRepStateNetSerializer (see DodgerNetTypes.cpp).
+ */
+USTRUCT()
+struct DODGER_API FDodgerCombatRepState
+{
+	GENERATED_BODY()
+
+	// Ticks per second of montage start time
+	static constexpr float MontageTickRate = 100.0f;
+
+	// Health in tenths of health point
+	uint16 QuantizedHealth = 0;
+
+	ECombatState State = ECombatState::Idle;
+
+	bool bInvulnerable = false;
+
+	// Server time when current montage started, in MontageTickRate ticks
+	uint32 MontageStartTick = 0;
+
+	void SetHealth(float Health) { QuantizedHealth = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Health * 10.0f), 0, MAX_uint16)); }
+
+	float GetHealth() const { return QuantizedHealth * 0.1f; }
+
+	void SetMontageStartTime(float ServerTime) { MontageStartTick = static_cast<uint32>(FMath::Max(FMath::RoundToInt(ServerTime * MontageTickRate), 0)); }
+
+	float GetMontageStartTime() const { return MontageStartTick / MontageTickRate; }
+
+	bool operator==(const FDodgerCombatRepState& Other) const
+	{
+		return QuantizedHealth == Other.QuantizedHealth && State == Other.State && bInvulnerable == Other.bInvulnerable && MontageStartTick == Other.MontageStartTick;
+	}
+
+	bool operator!=(const FDodgerCombatRepState& Other) const { return !(*this == Other); }
+
+	// Full state, used outside of property replication
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+private:
+	void SerializeFields(FArchive& Ar, uint8 FieldMask);
+};
+
+template<>
+struct TStructOpsTypeTraits<FDodgerCombatRepState> : public TStructOpsTypeTraitsBase2<FDodgerCombatRepState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -1,6 +1,9 @@
 
 #include "DodgerPlayerController.h"
 
+#include "DodgerNetAccounting.h"
+#include "Components/DodgerSoakBotComponent.h"
+
 float ADodgerPlayerController::GetServerTime() const
 {
 	if (HasAuthority())
@@ -8,7 +11,23 @@ float ADodgerPlayerController::GetServerTime() const
 		return GetWorld()->GetTimeSeconds();
 	}
 
-	return GetWorld()->GetTimeSeconds() + ClientServerDelta;
+	return ServerClock.GetServerTime(GetWorld()->GetTimeSeconds());
+}
+
+bool ADodgerPlayerController::IsServerTimeSynchronized() const
+{
+	return HasAuthority() || ServerClock.IsConverged();
+}
+
+void ADodgerPlayerController::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	FServerClockEstimator::FSettings Settings;
+	Settings.MaxSamples = TimeSyncWindowSize;
+	Settings.MinSyncInterval = MinTimeSyncInterval;
+	Settings.MaxSyncInterval = FMath::Max(MinTimeSyncInterval, MaxTimeSyncInterval);
+	ServerClock = FServerClockEstimator(Settings);
 }
 
 void ADodgerPlayerController::ReceivedPlayer()
@@ -16,9 +35,15 @@ void ADodgerPlayerController::ReceivedPlayer()
 	Super::ReceivedPlayer();
 
 	// Request sync time immediately when player is valid
-	if (IsLocalController())
+	if (IsLocalController() && !HasAuthority())
+	{
+		RequestServerTimeSync();
+	}
+
+	// Scripted soak test player drives the local pawn (see UDodgerSoakBotComponent)
+	if (IsLocalController() && UDodgerSoakBotComponent::IsRequested() && !FindComponentByClass<UDodgerSoakBotComponent>())
 	{
-		ServerSyncTime(GetWorld()->GetTimeSeconds());
+		NewObject<UDodgerSoakBotComponent>(this)->RegisterComponent();
 	}
 }
 
@@ -38,27 +63,41 @@ void ADodgerPlayerController::ServerSyncTime_Implementation(float ClientTime)
 
 void ADodgerPlayerController::ClientReportServerTime_Implementation(float ClientTime, float ServerTime)
 {
-	// Calculate round trip network delay
-	const float RoundTripTime = GetWorld()->GetTimeSeconds() - ClientTime;
-	
-	// Estimate one-way trip time (half of round trip)
-	const float SingleTripTime = 0.5f * RoundTripTime;
+	// Feed the filter, the applied offset converges in UpdateServerTimeSync
+	ServerClock.AddSample(ClientTime, ServerTime, GetWorld()->GetTimeSeconds());
+}
 
-	// Estimate current server time accounting for network latency
-	const float CurrentServerTime = ServerTime + SingleTripTime;
+void ADodgerPlayerController::UpdateServerTimeSync(float DeltaSeconds)
+{
+	// Server is the time authority
+	if (!IsLocalController() || HasAuthority())
+	{
+		return;
+	}
+
+	ServerClock.Advance(GetWorld()->GetTimeSeconds(), DeltaSeconds);
+
+	if ((TimeSyncCooldown -= DeltaSeconds) <= 0.0f)
+	{
+		RequestServerTimeSync();
+	}
+}
+
+void ADodgerPlayerController::RequestServerTimeSync()
+{
+	ServerSyncTime(GetWorld()->GetTimeSeconds());
 
-	// Update time difference between client and server
-	ClientServerDelta = CurrentServerTime - GetWorld()->GetTimeSeconds();
+	// Small random spread avoids synchronized bursts from many clients
+	const float Interval = ServerClock.GetNextSyncInterval();
+	TimeSyncCooldown = Interval * FMath::FRandRange(0.9f, 1.1f);
 }
 
-void ADodgerPlayerController::UpdateServerTimeSync(float DeltaSeconds)
+bool ADodgerPlayerController::CallRemoteFunction(UFunction* Function, void* Parms, FOutParmRec* OutParms, FFrame* Stack)
 {
-	if (IsLocalController())
+	if (UDodgerNetAccounting* NetAccounting = UDodgerNetAccounting::Get(this))
 	{
-		if ((TimeSyncRunningTime += DeltaSeconds) > TimeSyncFrequency)
-		{
-			ServerSyncTime(GetWorld()->GetTimeSeconds());
-			TimeSyncRunningTime = FMath::FRandRange(-1.0f, 1.0f);
-		}
+		NetAccounting->RecordRemoteFunction(this, Function, Parms);
 	}
+
+	return Super::CallRemoteFunction(Function, Parms, OutParms, Stack);
 }
@@ -1,8 +1,8 @@
-
 #pragma once
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "ServerClockEstimator.h"
 #include "DodgerPlayerController.generated.h"
 
 UCLASS()
@@ -16,43 +16,65 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable)
 	float GetServerTime() const;
+	/**
+	 * Whether the clock estimate has enough samples to be trusted
+	 */
+	bool IsServerTimeSynchronized() const;
     
 protected:
 	// Base Class Interface Start
+	virtual void PostInitializeComponents() override;
 	virtual void ReceivedPlayer() override;
 	virtual void Tick(float DeltaSeconds) override;
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parms, FOutParmRec* OutParms, FFrame* Stack) override;
 	// Base Class Interface End
 private:
 	/**
 	 * Server RPC to synchronize time between client and server.
+	 * Unreliable on purpose - a retransmitted request carries a stale round trip and only pollutes the filter.
 	 * @param ClientTime The client's current time when sending the request
 	 */
-	UFUNCTION(Server, Reliable)
+	UFUNCTION(Server, Unreliable)
 	void ServerSyncTime(float ClientTime);
 	/**
 	 * Client RPC to report server time back to the client.
 	 * @param ClientTime The original client time from the request
 	 * @param ServerTime The server's time when processing the request
 	 */
-	UFUNCTION(Client, Reliable)
+	UFUNCTION(Client, Unreliable)
 	void ClientReportServerTime(float ClientTime, float ServerTime);
 	/**
 	 * Updates the time synchronization logic
 	 */
 	void UpdateServerTimeSync(float DeltaSeconds);
+	/**
+	 * Sends sync request and schedules the next one
+	 */
+	void RequestServerTimeSync();
 	/** 
-	 * How often to synchronize time with server (in seconds).
+	 * Shortest time between synchronizations (in seconds), used while converging and on jittery links.
 	 * Configurable in editor.
 	 */
-	UPROPERTY(EditAnywhere)
-	float TimeSyncFrequency = 3.0f;
+	UPROPERTY(EditAnywhere, Category = "Time Sync")
+	float MinTimeSyncInterval = 0.5f;
+	/** 
+	 * Longest time between synchronizations (in seconds), used on stable links.
+	 * Configurable in editor.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Time Sync")
+	float MaxTimeSyncInterval = 10.0f;
+	/**
+	 * Number of sync samples kept by the clock filter.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Time Sync")
+	int32 TimeSyncWindowSize = 16;
 	/**
-	 * Synchronization cooldown.
+	 * Time left until the next synchronization.
 	 */
-	float TimeSyncRunningTime = 0.0f;
+	float TimeSyncCooldown = 0.0f;
 	/**
-	 * The calculated time difference between client and server (server - client).
+	 * Filtered estimate of the server clock.
 	 * Used to estimate server time locally.
 	 */
-	float ClientServerDelta = 0.0f;
+	FServerClockEstimator ServerClock;
 };
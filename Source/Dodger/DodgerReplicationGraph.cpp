@@ -0,0 +1,277 @@
+
+#include "DodgerReplicationGraph.h"
+
+#include "DodgerCharacter.h"
+#include "Projectile.h"
+#include "Data/ReplicationGraphConfig.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY_STATIC(DodgerRepGraphLog, Log, All);
+
+UDodgerReplicationGraph* UDodgerReplicationGraph::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		if (UNetDriver* NetDriver = World->GetNetDriver())
+		{
+			return Cast<UDodgerReplicationGraph>(NetDriver->GetReplicationDriver());
+		}
+	}
+
+	return nullptr;
+}
+
+void UDodgerReplicationGraph::UpdateCharacterRoute(ADodgerCharacter* Character)
+{
+	// Characters not added yet are routed by their state once they are
+	const ECharacterRoute* Route = CharacterRoutes.Find(TObjectKey<AActor>(Character));
+	if (!Route)
+	{
+		return;
+	}
+
+	const ECharacterRoute OldRoute = *Route;
+	const ECharacterRoute NewRoute = GetDesiredRoute(Character);
+	if (OldRoute == NewRoute)
+	{
+		return;
+	}
+
+	const FNewReplicatedActorInfo ActorInfo(Character);
+	RemoveCharacter(ActorInfo, OldRoute);
+	AddCharacter(ActorInfo, GlobalActorReplicationInfoMap.Get(Character), NewRoute);
+}
+
+void UDodgerReplicationGraph::ResetGameWorldState()
+{
+	Super::ResetGameWorldState();
+
+	CharacterRoutes.Reset();
+}
+
+void UDodgerReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Every machine spawns its own projectiles from the replicated attack, pool included
+	ClassRepNodePolicies.Set(AProjectile::StaticClass(), EClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), EClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(AReplicationGraphDebugActor::StaticClass(), EClassRepNodeMapping::NotRouted);
+	// Owner only, gathered by the per connection node as the connection's viewer
+	ClassRepNodePolicies.Set(APlayerController::StaticClass(), EClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(APlayerState::StaticClass(), EClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(ADodgerCharacter::StaticClass(), EClassRepNodeMapping::Spatialize_Dynamic);
+
+	// Frequency and cull distance of native classes, blueprints inherit them
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (!ActorCDO || !ActorCDO->GetIsReplicated() || Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		const EClassRepNodeMapping Mapping = GetMappingPolicy(Class);
+		FClassReplicationInfo ClassInfo;
+		InitClassReplicationInfo(ClassInfo, Class, Mapping >= EClassRepNodeMapping::Spatialize_Static);
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+
+	DeadCharacterPeriodFrame = GetReplicationPeriodFrameForFrequency(GetDefault<UReplicationGraphConfig>()->DeadCharacterUpdateFrequency);
+}
+
+void UDodgerReplicationGraph::InitGlobalGraphNodes()
+{
+	const UReplicationGraphConfig* Config = GetDefault<UReplicationGraphConfig>();
+
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = Config->CellSize;
+	GridNode->SpatialBias = Config->SpatialBias;
+	if (Config->bDisableSpatialRebuilds)
+	{
+		GridNode->AddToClassRebuildDenyList(AActor::StaticClass());
+	}
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	// Cull distance still applies to actor lists, only the gather isn't spatial
+	DeadCharacterNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(DeadCharacterNode);
+}
+
+void UDodgerReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* ConnectionManager)
+{
+	Super::InitConnectionGraphNodes(ConnectionManager);
+
+	// Connection's player controller, its pawn and view target
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantForConnectionNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantForConnectionNode, ConnectionManager);
+}
+
+void UDodgerReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	if (const ADodgerCharacter* Character = Cast<ADodgerCharacter>(ActorInfo.Actor))
+	{
+		AddCharacter(ActorInfo, GlobalInfo, GetDesiredRoute(Character));
+		return;
+	}
+
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EClassRepNodeMapping::NotRouted:
+		break;
+	case EClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	}
+}
+
+void UDodgerReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (Cast<ADodgerCharacter>(ActorInfo.Actor))
+	{
+		ECharacterRoute Route = ECharacterRoute::None;
+		if (CharacterRoutes.RemoveAndCopyValue(TObjectKey<AActor>(ActorInfo.Actor), Route))
+		{
+			RemoveCharacter(ActorInfo, Route);
+		}
+		return;
+	}
+
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EClassRepNodeMapping::NotRouted:
+		break;
+	case EClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	}
+}
+
+UDodgerReplicationGraph::EClassRepNodeMapping UDodgerReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	// Explicit policies are inherited, the rest is derived from the class defaults once
+	if (const EClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+	{
+		return *Policy;
+	}
+
+	const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+	EClassRepNodeMapping Mapping = EClassRepNodeMapping::Spatialize_Static;
+	if (ActorCDO->bOnlyRelevantToOwner)
+	{
+		Mapping = EClassRepNodeMapping::NotRouted;
+	}
+	else if (ActorCDO->bAlwaysRelevant)
+	{
+		Mapping = EClassRepNodeMapping::RelevantAllConnections;
+	}
+	else if (ActorCDO->IsReplicatingMovement())
+	{
+		Mapping = EClassRepNodeMapping::Spatialize_Dynamic;
+	}
+	else if (ActorCDO->NetDormancy > DORM_Awake)
+	{
+		Mapping = EClassRepNodeMapping::Spatialize_Dormancy;
+	}
+
+	UE_LOG(DodgerRepGraphLog, Verbose, TEXT("[%hs] %s routed as %d."), __func__, *Class->GetName(), static_cast<int32>(Mapping));
+
+	ClassRepNodePolicies.Set(Class, Mapping);
+	return Mapping;
+}
+
+void UDodgerReplicationGraph::InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialize) const
+{
+	const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+	if (bSpatialize)
+	{
+		Info.SetCullDistanceSquared(ActorCDO->NetCullDistanceSquared);
+	}
+	Info.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->NetUpdateFrequency);
+}
+
+void UDodgerReplicationGraph::AddCharacter(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo, ECharacterRoute Route)
+{
+	CharacterRoutes.Add(TObjectKey<AActor>(ActorInfo.Actor), Route);
+
+	switch (Route)
+	{
+	case ECharacterRoute::None:
+		break;
+	case ECharacterRoute::Grid:
+		// Dormant characters (see UDodgerDormancyManager) move to the grid's static list
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	case ECharacterRoute::Dead:
+		DeadCharacterNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	}
+
+	const uint32 PeriodFrame = Route == ECharacterRoute::Dead ? DeadCharacterPeriodFrame : GlobalActorReplicationInfoMap.GetClassInfo(ActorInfo.Class).ReplicationPeriodFrame;
+	SetReplicationPeriodFrame(ActorInfo.Actor, GlobalInfo, PeriodFrame);
+}
+
+void UDodgerReplicationGraph::RemoveCharacter(const FNewReplicatedActorInfo& ActorInfo, ECharacterRoute Route)
+{
+	switch (Route)
+	{
+	case ECharacterRoute::None:
+		break;
+	case ECharacterRoute::Grid:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	case ECharacterRoute::Dead:
+		DeadCharacterNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	}
+}
+
+void UDodgerReplicationGraph::SetReplicationPeriodFrame(AActor* Actor, FGlobalActorReplicationInfo& GlobalInfo, uint32 PeriodFrame)
+{
+	// Connections copy the period when they first see the actor, existing ones have to be updated too
+	GlobalInfo.Settings.ReplicationPeriodFrame = PeriodFrame;
+	for (UNetReplicationGraphConnection* Connection : Connections)
+	{
+		if (FConnectionReplicationActorInfo* ConnectionInfo = Connection->ActorInfoMap.Find(Actor))
+		{
+			ConnectionInfo->ReplicationPeriodFrame = PeriodFrame;
+		}
+	}
+}
+
+UDodgerReplicationGraph::ECharacterRoute UDodgerReplicationGraph::GetDesiredRoute(const ADodgerCharacter* Character)
+{
+	// Pooled characters are hidden until reused
+	if (Character->IsHidden())
+	{
+		return ECharacterRoute::None;
+	}
+
+	return Character->GetHealth() > 0.0f ? ECharacterRoute::Grid : ECharacterRoute::Dead;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "UObject/ObjectKey.h"
+#include "DodgerReplicationGraph.generated.h"
+
+class ADodgerCharacter;
+
+/**
+ * Replication graph replacing per connection relevancy checks of every actor (server only).
+ * Living characters go to a spatial grid so each connection only gathers nearby cells, player states and
+ * always relevant actors go to a shared list, dead characters to a low frequency list and pooled
+ * characters nowhere. Projectiles are simulated on every machine and never replicated.
+ * Enabled by ReplicationDriverClassName in DefaultEngine.ini, settings come from UReplicationGraphConfig.
+ * Not used under Iris, which filters characters with its Spatial filter (ObjectReplicationBridgeConfig).
+ */
+UCLASS(Transient)
+class DODGER_API UDodgerReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	static UDodgerReplicationGraph* Get(const UObject* WorldContext);
+	/**
+	 * Re-route character after death or pool (de)activation (server only)
+	 */
+	void UpdateCharacterRoute(ADodgerCharacter* Character);
+
+	// Base Interface Start
+	virtual void ResetGameWorldState() override;
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* ConnectionManager) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	// Base Interface End
+
+private:
+	enum class EClassRepNodeMapping : uint8
+	{
+		NotRouted,
+		RelevantAllConnections,
+		Spatialize_Static,
+		Spatialize_Dynamic,
+		Spatialize_Dormancy
+	};
+
+	enum class ECharacterRoute : uint8
+	{
+		None,
+		Grid,
+		Dead
+	};
+
+	EClassRepNodeMapping GetMappingPolicy(UClass* Class);
+	void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialize) const;
+	
+	void AddCharacter(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo, ECharacterRoute Route);
+	void RemoveCharacter(const FNewReplicatedActorInfo& ActorInfo, ECharacterRoute Route);
+	void SetReplicationPeriodFrame(AActor* Actor, FGlobalActorReplicationInfo& GlobalInfo, uint32 PeriodFrame);
+	static ECharacterRoute GetDesiredRoute(const ADodgerCharacter* Character);
+	
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> DeadCharacterNode;
+
+	TClassMap<EClassRepNodeMapping> ClassRepNodePolicies;
+
+	// Node every replicated character currently is in
+	TMap<TObjectKey<AActor>, ECharacterRoute> CharacterRoutes;
+	
+	uint32 DeadCharacterPeriodFrame = 1;
+};
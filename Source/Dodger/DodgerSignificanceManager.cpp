@@ -0,0 +1,198 @@
+
+#include "DodgerSignificanceManager.h"
+
+#include "DodgerCharacter.h"
+#include "Components/DodgerCombatComponent.h"
+#include "Data/SignificanceConfig.h"
+#include "DodgerStressTimings.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+namespace
+{
+	const FName SignificanceTag_Character(TEXT("DodgerCharacter"));
+
+	// Locally controlled characters always use the top tier
+	constexpr float LocalPlayerSignificance = 100.0f;
+
+	// Time window for "recently rendered"
+	constexpr float RecentlyRenderedTolerance = 0.2f;
+}
+
+UDodgerSignificanceManager* UDodgerSignificanceManager::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UDodgerSignificanceManager>();
+	}
+
+	return nullptr;
+}
+
+bool UDodgerSignificanceManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDodgerSignificanceManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Config = GetDefault<USignificanceConfig>();
+}
+
+void UDodgerSignificanceManager::RegisterCharacter(ADodgerCharacter* Character)
+{
+	// Only remote copies are throttled - authority (dedicated or listen server, standalone) simulates movement,
+	// montage notifies and hitboxes at full rate
+	if (!Character || Character->HasAuthority() || GetWorld()->IsNetMode(NM_DedicatedServer) || Config->Tiers.IsEmpty())
+	{
+		return;
+	}
+
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+	if (!SignificanceManager)
+	{
+		return;
+	}
+
+	// Starts at zero significance until the first update scores it, registration may score it right away
+	ApplyTier(Character, GetTierIndex(0.0f));
+
+	SignificanceManager->RegisterObject(Character, SignificanceTag_Character,
+		[this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+		{
+			return CalculateSignificance(ObjectInfo, Viewpoint);
+		},
+		USignificanceManager::EPostSignificanceType::Sequential,
+		[this](USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+		{
+			OnSignificanceChanged(ObjectInfo, OldSignificance, Significance, bFinal);
+		});
+}
+
+void UDodgerSignificanceManager::UnregisterCharacter(ADodgerCharacter* Character)
+{
+	AppliedTiers.Remove(TObjectKey<ADodgerCharacter>(Character));
+
+	if (USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(Character);
+	}
+}
+
+void UDodgerSignificanceManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DODGER_STRESS_TIMING_SCOPE("Significance");
+
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+	if (!SignificanceManager || GetWorld()->IsNetMode(NM_DedicatedServer))
+	{
+		return;
+	}
+
+	Viewpoints.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			Viewpoints.Emplace(ViewRotation, ViewLocation);
+		}
+	}
+
+	SignificanceManager->Update(Viewpoints);
+}
+
+float UDodgerSignificanceManager::CalculateSignificance(USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) const
+{
+	const ADodgerCharacter* Character = Cast<ADodgerCharacter>(ObjectInfo->GetObject());
+	if (!Character)
+	{
+		return 0.0f;
+	}
+
+	if (Character->IsLocallyControlled())
+	{
+		return LocalPlayerSignificance;
+	}
+
+	const float Distance = FVector::Distance(Character->GetActorLocation(), Viewpoint.GetLocation());
+	float Significance = 1.0f - FMath::Clamp(Distance / FMath::Max(Config->MaxDistance, 1.0f), 0.0f, 1.0f);
+
+	if (!Character->WasRecentlyRendered(RecentlyRenderedTolerance))
+	{
+		Significance *= Config->NotRenderedScale;
+	}
+
+	if (Character->IsAttacking() || Character->IsDodging() || Character->GetHealth() <= 0.0f)
+	{
+		Significance += Config->CombatBonus;
+	}
+
+	return Significance;
+}
+
+void UDodgerSignificanceManager::OnSignificanceChanged(USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+{
+	ApplyTier(Cast<ADodgerCharacter>(ObjectInfo->GetObject()), GetTierIndex(Significance));
+}
+
+int32 UDodgerSignificanceManager::GetTierIndex(float Significance) const
+{
+	for (int32 Index = 0; Index < Config->Tiers.Num(); ++Index)
+	{
+		if (Significance >= Config->Tiers[Index].MinSignificance)
+		{
+			return Index;
+		}
+	}
+
+	return Config->Tiers.Num() - 1;
+}
+
+void UDodgerSignificanceManager::ApplyTier(ADodgerCharacter* Character, int32 TierIndex)
+{
+	if (!Character)
+	{
+		return;
+	}
+
+	// Compared against the tier actually applied, old significance may have never been applied
+	int32& AppliedTier = AppliedTiers.FindOrAdd(TObjectKey<ADodgerCharacter>(Character), INDEX_NONE);
+	if (AppliedTier == TierIndex)
+	{
+		return;
+	}
+	AppliedTier = TierIndex;
+
+	const FDodgerSignificanceTier& Tier = Config->Tiers[TierIndex];
+
+	Character->SetActorTickInterval(Tier.TickInterval);
+	Character->GetCharacterMovement()->SetComponentTickInterval(Tier.TickInterval);
+
+	USkeletalMeshComponent* Mesh = Character->GetMesh();
+	Mesh->SetComponentTickInterval(Tier.TickInterval);
+	Mesh->VisibilityBasedAnimTickOption = Tier.AnimTickOption;
+
+	// Fixed frame skip instead of the default screen size based one
+	Mesh->bEnableUpdateRateOptimizations = Tier.AnimFrameSkip > 0;
+	if (FAnimUpdateRateParameters* UpdateRateParams = Mesh->AnimUpdateRateParams)
+	{
+		UpdateRateParams->bShouldUseLodMap = true;
+		UpdateRateParams->LODToFrameSkipMap.Reset();
+		for (int32 LODIndex = 0; LODIndex < Mesh->GetNumLODs(); ++LODIndex)
+		{
+			UpdateRateParams->LODToFrameSkipMap.Add(LODIndex, Tier.AnimFrameSkip);
+		}
+	}
+}
+
+TStatId UDodgerSignificanceManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDodgerSignificanceManager, STATGROUP_Tickables);
+}
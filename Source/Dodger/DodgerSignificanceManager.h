@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SignificanceManager.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DodgerSignificanceManager.generated.h"
+
+class ADodgerCharacter;
+class USignificanceConfig;
+
+/**
+ * Scores remote (non authority) Dodger characters through the engine significance manager.
+ * Significance comes from distance to local viewpoints, recent visibility and combat involvement;
+ * tiers of USignificanceConfig then drive tick intervals and animation update rate of each character.
+ */
+UCLASS()
+class DODGER_API UDodgerSignificanceManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDodgerSignificanceManager* Get(const UObject* WorldContext);
+	/**
+	 *  Start/stop managing character
+	 */
+	void RegisterCharacter(ADodgerCharacter* Character);
+	void UnregisterCharacter(ADodgerCharacter* Character);
+	
+	// Base Interface Start
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	
+private:
+	float CalculateSignificance(USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) const;
+	void OnSignificanceChanged(USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal);
+	int32 GetTierIndex(float Significance) const;
+	void ApplyTier(ADodgerCharacter* Character, int32 TierIndex);
+	
+	UPROPERTY(Transient)
+	TObjectPtr<const USignificanceConfig> Config;
+
+	TArray<FTransform> Viewpoints;
+
+	// Tier last applied to each character
+	TMap<TObjectKey<ADodgerCharacter>, int32> AppliedTiers;
+};
@@ -0,0 +1,244 @@
+
+#include "DodgerSoakRecorder.h"
+
+#include "DodgerStressTimings.h"
+#include "Dom/JsonObject.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+DEFINE_LOG_CATEGORY_STATIC(DodgerSoakLog, Log, All);
+
+namespace
+{
+	// Engine connection stats (In/OutBytesPerSecond) are updated once per second
+	constexpr double BandwidthSampleInterval = 1.0;
+
+	TSharedRef<FJsonObject> MakeSummaryObject(const TArray<float>& Samples)
+	{
+		const FDodgerSampleSummary Summary = FDodgerSampleSummary::Make(Samples);
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetNumberField(TEXT("Count"), Summary.Count);
+		Object->SetNumberField(TEXT("Avg"), Summary.Average);
+		Object->SetNumberField(TEXT("P50"), Summary.P50);
+		Object->SetNumberField(TEXT("P90"), Summary.P90);
+		Object->SetNumberField(TEXT("P95"), Summary.P95);
+		Object->SetNumberField(TEXT("P99"), Summary.P99);
+		Object->SetNumberField(TEXT("Max"), Summary.Max);
+		return Object;
+	}
+}
+
+UDodgerSoakRecorder* UDodgerSoakRecorder::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UDodgerSoakRecorder>();
+	}
+
+	return nullptr;
+}
+
+bool UDodgerSoakRecorder::IsRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("DodgerSoak"));
+}
+
+void UDodgerSoakRecorder::RecordHitVerification(bool bAccepted)
+{
+	if (!bMeasuring)
+	{
+		return;
+	}
+	
+	if (bAccepted)
+	{
+		++HitsAccepted;
+	}
+	else
+	{
+		++HitsRejected;
+	}
+}
+
+bool UDodgerSoakRecorder::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && IsRequested();
+}
+
+void UDodgerSoakRecorder::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	GEngine->OnNetworkFailure().AddUObject(this, &ThisClass::HandleNetworkFailure);
+}
+
+void UDodgerSoakRecorder::Deinitialize()
+{
+	GEngine->OnNetworkFailure().RemoveAll(this);
+
+	Super::Deinitialize();
+}
+
+bool UDodgerSoakRecorder::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDodgerSoakRecorder::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Clients start in a standalone entry world before travelling to the server map
+	if (bFinished || !GetWorld()->HasBegunPlay() || GetWorld()->IsNetMode(NM_Standalone))
+	{
+		return;
+	}
+	
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (StartTime < 0.0)
+	{
+		StartTime = Now;
+		FParse::Value(FCommandLine::Get(), TEXT("SoakWarmup="), Warmup);
+		FParse::Value(FCommandLine::Get(), TEXT("SoakDuration="), Duration);
+		Duration = FMath::Max(Duration, 1.0f);
+		
+		UE_LOG(DodgerSoakLog, Log, TEXT("[%hs] Recording %s for %.0f s after %.0f s warmup."), __func__, *GetRole(), Duration, Warmup);
+	}
+
+	const double Measured = Now - StartTime - Warmup;
+	if (Measured < 0.0)
+	{
+		return;
+	}
+
+	if (Measured >= Duration)
+	{
+		Finish();
+		return;
+	}
+
+	bMeasuring = true;
+
+	// Frame time includes waiting for the server tick rate, game thread time is the actual work
+	FrameTimes.Add(DeltaTime * 1000.0f);
+	GameThreadTimes.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+
+	if (Now >= NextBandwidthSampleTime)
+	{
+		SampleBandwidth();
+		NextBandwidthSampleTime = Now + BandwidthSampleInterval;
+	}
+}
+
+void UDodgerSoakRecorder::HandleNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
+{
+	// Failed world falls back to a standalone one where nothing is recorded - report what we have instead of waiting forever
+	if (World != GetWorld() || bFinished)
+	{
+		return;
+	}
+
+	UE_LOG(DodgerSoakLog, Warning, TEXT("[%hs] Network failure (%s), finishing %s early."), __func__, ENetworkFailure::ToString(FailureType), *GetRole());
+	Finish(FString::Printf(TEXT("%s: %s"), ENetworkFailure::ToString(FailureType), *ErrorString));
+}
+
+void UDodgerSoakRecorder::Finish(const FString& InFailure)
+{
+	Failure = InFailure;
+	bFinished = true;
+	WriteReport();
+	FPlatformMisc::RequestExit(false);
+}
+
+void UDodgerSoakRecorder::SampleBandwidth()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver)
+	{
+		return;
+	}
+
+	TArray<UNetConnection*, TInlineAllocator<16>> Connections;
+	if (NetDriver->ServerConnection)
+	{
+		Connections.Add(NetDriver->ServerConnection);
+	}
+	Connections.Append(NetDriver->ClientConnections);
+
+	int64 InBytes = 0;
+	int64 OutBytes = 0;
+	float OutLoss = 0.0f;
+	for (UNetConnection* Connection : Connections)
+	{
+		InBytes += Connection->InBytesPerSecond;
+		OutBytes += Connection->OutBytesPerSecond;
+		OutLoss += Connection->GetOutLossPercentage().GetAvgLossPercentage();
+	}
+
+	InBytesPerSecond.Add(static_cast<float>(InBytes));
+	OutBytesPerSecond.Add(static_cast<float>(OutBytes));
+	OutLossPercentages.Add(Connections.IsEmpty() ? 0.0f : OutLoss * 100.0f / Connections.Num());
+	MaxConnections = FMath::Max(MaxConnections, Connections.Num());
+}
+
+void UDodgerSoakRecorder::WriteReport() const
+{
+	const FString Role = GetRole();
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Role"), Role);
+	Report->SetStringField(TEXT("Map"), GetWorld()->GetMapName());
+	Report->SetNumberField(TEXT("ProcessId"), FPlatformProcess::GetCurrentProcessId());
+	Report->SetNumberField(TEXT("Duration"), Duration);
+	Report->SetBoolField(TEXT("Completed"), Failure.IsEmpty());
+	if (!Failure.IsEmpty())
+	{
+		Report->SetStringField(TEXT("Failure"), Failure);
+	}
+	Report->SetNumberField(TEXT("MaxConnections"), MaxConnections);
+	Report->SetObjectField(TEXT("FrameTimeMs"), MakeSummaryObject(FrameTimes));
+	Report->SetObjectField(TEXT("GameThreadTimeMs"), MakeSummaryObject(GameThreadTimes));
+	Report->SetObjectField(TEXT("InBytesPerSecond"), MakeSummaryObject(InBytesPerSecond));
+	Report->SetObjectField(TEXT("OutBytesPerSecond"), MakeSummaryObject(OutBytesPerSecond));
+	Report->SetObjectField(TEXT("OutLossPercent"), MakeSummaryObject(OutLossPercentages));
+
+	// Hits are only verified on the server
+	if (!GetWorld()->IsNetMode(NM_Client))
+	{
+		TSharedRef<FJsonObject> Hits = MakeShared<FJsonObject>();
+		Hits->SetNumberField(TEXT("Accepted"), HitsAccepted);
+		Hits->SetNumberField(TEXT("Rejected"), HitsRejected);
+		Report->SetObjectField(TEXT("HitValidation"), Hits);
+	}
+
+	FString Json;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&Json));
+
+	FString Directory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("Soak"));
+	FParse::Value(FCommandLine::Get(), TEXT("SoakReportDir="), Directory);
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	
+	const FString FileName = FPaths::Combine(Directory, FString::Printf(TEXT("%s-%u.json"), *Role, FPlatformProcess::GetCurrentProcessId()));
+	if (FFileHelper::SaveStringToFile(Json, *FileName))
+	{
+		UE_LOG(DodgerSoakLog, Log, TEXT("[%hs] Report written to %s."), __func__, *FileName);
+	}
+	else
+	{
+		UE_LOG(DodgerSoakLog, Error, TEXT("[%hs] Failed to write report %s."), __func__, *FileName);
+	}
+}
+
+FString UDodgerSoakRecorder::GetRole() const
+{
+	return GetWorld()->IsNetMode(NM_Client) ? TEXT("Client") : TEXT("Server");
+}
+
+TStatId UDodgerSoakRecorder::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDodgerSoakRecorder, STATGROUP_Tickables);
+}
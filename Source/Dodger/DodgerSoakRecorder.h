@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DodgerSoakRecorder.generated.h"
+
+class UNetDriver;
+
+/**
+ * Records one process of a multi-client soak test (created only with -DodgerSoak, in networked worlds).
+ * Servers record tick time, bandwidth and hit validation results, clients record frame time and bandwidth.
+ * After warmup it measures for a fixed time, writes a JSON report and exits. Network failure (e.g. server
+ * gone before client finished) writes the partial report and exits as well. Scripts/Soak/RunSoakTest.sh
+ * launches the server and bot clients (-DodgerBot) and merges their reports:
+ *
+ *   DodgerServer <Map> -nullrhi -log -DodgerSoak -SoakDuration=120 -SoakWarmup=10 -SoakReportDir=<Dir>
+ */
+UCLASS()
+class DODGER_API UDodgerSoakRecorder : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDodgerSoakRecorder* Get(const UObject* WorldContext);
+	static bool IsRequested();
+
+	/**
+	 * Result of server side hit verification (see UHitValidationComponent)
+	 */
+	void RecordHitVerification(bool bAccepted);
+	
+	// Base Interface Start
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void SampleBandwidth();
+	void HandleNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString);
+	void Finish(const FString& InFailure = FString());
+	void WriteReport() const;
+	FString GetRole() const;
+
+	TArray<float> FrameTimes;
+	TArray<float> GameThreadTimes;
+
+	// Per second totals over all connections
+	TArray<float> InBytesPerSecond;
+	TArray<float> OutBytesPerSecond;
+	TArray<float> OutLossPercentages;
+	int32 MaxConnections = 0;
+	
+	int32 HitsAccepted = 0;
+	int32 HitsRejected = 0;
+
+	float Warmup = 10.0f;
+	float Duration = 120.0f;
+	
+	bool bMeasuring = false;
+	bool bFinished = false;
+	// Why recording ended early, empty when it completed
+	FString Failure;
+	double StartTime = -1.0;
+	double NextBandwidthSampleTime = 0.0;
+};
@@ -0,0 +1,36 @@
+
+#include "DodgerStats.h"
+
+CSV_DEFINE_CATEGORY_MODULE(DODGER_API, Dodger, true);
+
+LLM_DEFINE_TAG(Dodger);
+LLM_DEFINE_TAG(Dodger_Projectiles, TEXT("Projectiles"), TEXT("Dodger"));
+LLM_DEFINE_TAG(Dodger_HitValidation, TEXT("HitValidation"), TEXT("Dodger"));
+LLM_DEFINE_TAG(Dodger_AI, TEXT("AI"), TEXT("Dodger"));
+LLM_DEFINE_TAG(Dodger_Perception, TEXT("Perception"), TEXT("Dodger"));
+LLM_DEFINE_TAG(Dodger_Materials, TEXT("Materials"), TEXT("Dodger"));
+
+DEFINE_STAT(STAT_DodgerLaunchProjectile);
+DEFINE_STAT(STAT_DodgerProjectileHit);
+DEFINE_STAT(STAT_DodgerProjectilesLaunched);
+DEFINE_STAT(STAT_DodgerProjectilesSpawned);
+DEFINE_STAT(STAT_DodgerProjectileHits);
+
+DEFINE_STAT(STAT_DodgerHitValidationSave);
+DEFINE_STAT(STAT_DodgerHitValidationRewind);
+DEFINE_STAT(STAT_DodgerHitValidationVerify);
+DEFINE_STAT(STAT_DodgerHitsConfirmed);
+DEFINE_STAT(STAT_DodgerHitsRejected);
+
+DEFINE_STAT(STAT_DodgerUpdateCombat);
+DEFINE_STAT(STAT_DodgerCombatUpdates);
+
+DEFINE_STAT(STAT_DodgerAIUpdate);
+DEFINE_STAT(STAT_DodgerAIGather);
+DEFINE_STAT(STAT_DodgerAIEvaluate);
+DEFINE_STAT(STAT_DodgerAIApply);
+DEFINE_STAT(STAT_DodgerAIUpdates);
+
+DEFINE_STAT(STAT_DodgerResolveDamage);
+DEFINE_STAT(STAT_DodgerApplyDamage);
+DEFINE_STAT(STAT_DodgerDamageApplied);
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+/**
+ * Game stats - "stat Dodger" in game, same scopes show up in Insights (cpu channel) and CSV captures (Dodger category).
+ */
+DECLARE_STATS_GROUP(TEXT("Dodger"), STATGROUP_Dodger, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(DODGER_API, Dodger);
+
+// Projectiles
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Launch Projectile"), STAT_DodgerLaunchProjectile, STATGROUP_Dodger, DODGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Hit"), STAT_DodgerProjectileHit, STATGROUP_Dodger, DODGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectiles Launched"), STAT_DodgerProjectilesLaunched, STATGROUP_Dodger, DODGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectiles Spawned"), STAT_DodgerProjectilesSpawned, STATGROUP_Dodger, DODGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Hits"), STAT_DodgerProjectileHits, STATGROUP_Dodger, DODGER_API);
+
+// Hit validation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hit Validation Save"), STAT_DodgerHitValidationSave, STATGROUP_Dodger, DODGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hit Validation Rewind"), STAT_DodgerHitValidationRewind, STATGROUP_Dodger, DODGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hit Validation Verify"), STAT_DodgerHitValidationVerify, STATGROUP_Dodger, DODGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hits Confirmed"), STAT_DodgerHitsConfirmed, STATGROUP_Dodger, DODGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hits Rejected"), STAT_DodgerHitsRejected, STATGROUP_Dodger, DODGER_API);
+
+// Combat
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Combat"), STAT_DodgerUpdateCombat, STATGROUP_Dodger, DODGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Combat Updates"), STAT_DodgerCombatUpdates, STATGROUP_Dodger, DODGER_API);
+
+// Enemy AI
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Update"), STAT_DodgerAIUpdate, STATGROUP_Dodger, DODGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Gather Inputs"), STAT_DodgerAIGather, STATGROUP_Dodger, DODGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Evaluate Decisions"), STAT_DodgerAIEvaluate, STATGROUP_Dodger, DODGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Apply Decisions"), STAT_DodgerAIApply, STATGROUP_Dodger, DODGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("AI Updates"), STAT_DodgerAIUpdates, STATGROUP_Dodger, DODGER_API);
+
+// Damage
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve Damage"), STAT_DodgerResolveDamage, STATGROUP_Dodger, DODGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Damage"), STAT_DodgerApplyDamage, STATGROUP_Dodger, DODGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Applied"), STAT_DodgerDamageApplied, STATGROUP_Dodger, DODGER_API);
+
+// Memory tags - "stat LLM" / -llm, see also UDodgerMemoryTracker
+LLM_DECLARE_TAG_API(Dodger, DODGER_API);
+LLM_DECLARE_TAG_API(Dodger_Projectiles, DODGER_API);
+LLM_DECLARE_TAG_API(Dodger_HitValidation, DODGER_API);
+LLM_DECLARE_TAG_API(Dodger_AI, DODGER_API);
+LLM_DECLARE_TAG_API(Dodger_Perception, DODGER_API);
+LLM_DECLARE_TAG_API(Dodger_Materials, DODGER_API);
+
+// Cycle stat, Insights scope and CSV timing of the enclosing scope
+#define DODGER_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+	CSV_SCOPED_TIMING_STAT(Dodger, Stat)
+
+// Per frame counter in stats and CSV captures
+#define DODGER_INC_COUNTER(Stat, Amount) \
+	INC_DWORD_STAT_BY(Stat, Amount); \
+	CSV_CUSTOM_STAT(Dodger, Stat, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate)
@@ -0,0 +1,360 @@
+
+#include "DodgerStressTest.h"
+
+#include "DodgerCharacter.h"
+#include "DodgerStressTimings.h"
+#include "EngineUtils.h"
+#include "EnemyAIController.h"
+#include "EnemySpawner.h"
+#include "NavigationSystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Data/EnemySpawnTable.h"
+#include "Data/StressTestConfig.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(DodgerStressTestLog, Log, All);
+
+namespace
+{
+	// Time between bots picking their nearest enemy
+	constexpr double RetargetInterval = 0.5;
+
+	constexpr int32 NumPhases = 3;
+}
+
+UDodgerStressTest* UDodgerStressTest::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UDodgerStressTest>();
+	}
+
+	return nullptr;
+}
+
+bool UDodgerStressTest::IsRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("DodgerStressTest"));
+}
+
+bool UDodgerStressTest::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && IsRequested();
+}
+
+bool UDodgerStressTest::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDodgerStressTest::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bFinished)
+	{
+		return;
+	}
+
+	// Actors spawned before begin play would wait for it anyway
+	if (!bStarted)
+	{
+		if (GetWorld()->HasBegunPlay() && !GetWorld()->IsNetMode(NM_Client))
+		{
+			Start();
+		}
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double Measured = Now - StartTime - Config->WarmupTime;
+	if (Measured < 0.0)
+	{
+		return;
+	}
+
+	if (Measured >= Duration)
+	{
+		CollectSystemTimes();
+		FDodgerStressTimings::SetEnabled(false);
+		WriteReport();
+		bFinished = true;
+		FPlatformMisc::RequestExit(false);
+		return;
+	}
+
+	if (!bMeasuring)
+	{
+		bMeasuring = true;
+		FDodgerStressTimings::Reset();
+		FDodgerStressTimings::SetEnabled(true);
+	}
+
+	const int32 PhaseIndex = FMath::Min(FMath::FloorToInt32(Measured * NumPhases / Duration), NumPhases - 1);
+	if (PhaseIndex != static_cast<int32>(Phase))
+	{
+		CollectSystemTimes();
+		SetPhase(static_cast<EDodgerBotPhase>(PhaseIndex));
+	}
+
+	RecordFrame(DeltaTime);
+
+	if (Now >= NextRetargetTime)
+	{
+		UpdateBotTargets();
+		NextRetargetTime = Now + RetargetInterval;
+	}
+
+	for (ADodgerBotController* Bot : Bots)
+	{
+		if (Bot)
+		{
+			Bot->UpdateBot(Now);
+		}
+	}
+}
+
+void UDodgerStressTest::Start()
+{
+	bStarted = true;
+	StartTime = GetWorld()->GetTimeSeconds();
+
+	Config = GetDefault<UStressTestConfig>();
+	NumEnemies = Config->NumEnemies;
+	NumBots = Config->NumBots;
+	Duration = Config->Duration;
+	FParse::Value(FCommandLine::Get(), TEXT("StressEnemies="), NumEnemies);
+	FParse::Value(FCommandLine::Get(), TEXT("StressBots="), NumBots);
+	FParse::Value(FCommandLine::Get(), TEXT("StressDuration="), Duration);
+	Duration = FMath::Max(Duration, 1.0f);
+
+	UE_LOG(DodgerStressTestLog, Log, TEXT("[%hs] Starting with %d enemies, %d bots, %.0f s."), __func__, NumEnemies, NumBots, Duration);
+
+	// Enemies go through the regular spawner - one wave spawned at once, each enemy respawned after its corpse
+	// returns to the pool, so the enemy count stays constant through all phases
+	if (NumEnemies > 0)
+	{
+		SpawnTable = NewObject<UEnemySpawnTable>(this);
+		SpawnTable->bLoopWaves = true;
+		SpawnTable->bRespawnReleased = true;
+		SpawnTable->SpawnRadius = Config->SpawnRadius;
+		SpawnTable->CorpseLifetime = Config->EnemyRespawnDelay;
+		SpawnTable->PrewarmCount = NumEnemies;
+		
+		FEnemyWave& Wave = SpawnTable->Waves.AddDefaulted_GetRef();
+		Wave.EnemyClass = Config->EnemyClass.LoadSynchronous();
+		Wave.Count = NumEnemies;
+		Wave.StartDelay = 0.0f;
+		Wave.SpawnInterval = 0.0f;
+
+		UEnemySpawner::Get(this)->StartWaves(SpawnTable);
+	}
+
+	SpawnBots(NumBots);
+}
+
+void UDodgerStressTest::SpawnBots(int32 Count)
+{
+	const TSubclassOf<ADodgerCharacter> BotClass = Config->BotClass.LoadSynchronous();
+	if (!BotClass)
+	{
+		UE_LOG(DodgerStressTestLog, Error, TEXT("[%hs] Bot class %s not found."), __func__, *Config->BotClass.ToString());
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	const float HalfHeight = BotClass->GetDefaultObject<ADodgerCharacter>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		FVector Location;
+		FVector Origin;
+		if (!FindSpawnLocation(Location, Origin))
+		{
+			UE_LOG(DodgerStressTestLog, Warning, TEXT("[%hs] No spawn location found."), __func__);
+			return;
+		}
+		
+		Location.Z += HalfHeight;
+
+		ADodgerCharacter* Character = GetWorld()->SpawnActor<ADodgerCharacter>(BotClass, Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Character)
+		{
+			continue;
+		}
+
+		if (AController* DefaultController = Character->GetController())
+		{
+			DefaultController->UnPossess();
+			DefaultController->Destroy();
+		}
+
+		ADodgerBotController* Bot = GetWorld()->SpawnActor<ADodgerBotController>(SpawnParams);
+		Bot->Possess(Character);
+		Bot->SetRoamArea(Origin, Config->SpawnRadius);
+		Bot->SetDodgeInterval(Config->BotDodgeInterval);
+
+		// Bots measure the load they cause, dying would only change it
+		Character->SetCanBeDamaged(false);
+		
+		Bots.Add(Bot);
+	}
+}
+
+bool UDodgerStressTest::FindSpawnLocation(FVector& OutLocation, FVector& OutOrigin) const
+{
+	TArray<const APlayerStart*, TInlineAllocator<8>> PlayerStarts;
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		PlayerStarts.Add(*It);
+	}
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (PlayerStarts.IsEmpty() || !NavSys)
+	{
+		return false;
+	}
+
+	OutOrigin = PlayerStarts[FMath::RandHelper(PlayerStarts.Num())]->GetActorLocation();
+	FNavLocation Result;
+	if (NavSys->GetRandomReachablePointInRadius(OutOrigin, Config->SpawnRadius, Result))
+	{
+		OutLocation = Result.Location;
+		return true;
+	}
+
+	return false;
+}
+
+void UDodgerStressTest::SetPhase(EDodgerBotPhase NewPhase)
+{
+	Phase = NewPhase;
+
+	UE_LOG(DodgerStressTestLog, Log, TEXT("[%hs] Entering %s phase."), __func__, *StaticEnum<EDodgerBotPhase>()->GetNameStringByValue(static_cast<int64>(Phase)));
+
+	for (ADodgerBotController* Bot : Bots)
+	{
+		if (Bot)
+		{
+			Bot->SetPhase(Phase);
+		}
+	}
+}
+
+void UDodgerStressTest::UpdateBotTargets()
+{
+	if (Phase != EDodgerBotPhase::Combat)
+	{
+		return;
+	}
+
+	TArray<APawn*> Enemies;
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		const AEnemyAIController* EnemyAI = Cast<AEnemyAIController>(It->Get());
+		APawn* Pawn = EnemyAI ? EnemyAI->GetPawn() : nullptr;
+		const IDodgerCombatInterface* Combat = Cast<IDodgerCombatInterface>(Pawn);
+		if (Combat && Combat->GetHealth() > 0.0f)
+		{
+			Enemies.Add(Pawn);
+		}
+	}
+
+	for (ADodgerBotController* Bot : Bots)
+	{
+		const APawn* BotPawn = Bot ? Bot->GetPawn() : nullptr;
+		if (!BotPawn)
+		{
+			continue;
+		}
+
+		APawn* Nearest = nullptr;
+		double NearestDistSq = UE_BIG_NUMBER;
+		for (APawn* Enemy : Enemies)
+		{
+			const double DistSq = FVector::DistSquared(BotPawn->GetActorLocation(), Enemy->GetActorLocation());
+			if (DistSq < NearestDistSq)
+			{
+				NearestDistSq = DistSq;
+				Nearest = Enemy;
+			}
+		}
+		Bot->SetCombatTarget(Nearest);
+	}
+}
+
+void UDodgerStressTest::RecordFrame(float DeltaTime)
+{
+	// Frame time includes waiting for the server tick rate, game thread time is the actual work
+	FPhaseSamples& Samples = PhaseSamples[static_cast<int32>(Phase)];
+	Samples.FrameTimes.Add(DeltaTime * 1000.0f);
+	Samples.GameThreadTimes.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+}
+
+void UDodgerStressTest::CollectSystemTimes()
+{
+	FPhaseSamples& Samples = PhaseSamples[static_cast<int32>(Phase)];
+	for (const TPair<FString, FDodgerStressTimings::FEntry>& Entry : FDodgerStressTimings::GetEntries())
+	{
+		Samples.SystemTimes.FindOrAdd(Entry.Key) += Entry.Value.TotalSeconds;
+		double& MaxTime = Samples.SystemMaxTimes.FindOrAdd(Entry.Key);
+		MaxTime = FMath::Max(MaxTime, Entry.Value.MaxSeconds);
+	}
+	FDodgerStressTimings::Reset();
+}
+
+void UDodgerStressTest::WriteReport() const
+{
+	TArray<FString> Lines;
+	Lines.Add(FString::Printf(TEXT("Enemies,%d,Bots,%d,Duration,%.0f"), NumEnemies, NumBots, Duration));
+	Lines.Add(TEXT("Phase,Metric,Samples,AvgMs,P50Ms,P90Ms,P95Ms,P99Ms,MaxMs"));
+
+	for (int32 PhaseIndex = 0; PhaseIndex < NumPhases; ++PhaseIndex)
+	{
+		const FPhaseSamples& Samples = PhaseSamples[PhaseIndex];
+		const FString PhaseName = StaticEnum<EDodgerBotPhase>()->GetNameStringByValue(PhaseIndex);
+
+		auto AddPercentiles = [&Lines, &PhaseName](const TCHAR* Metric, const TArray<float>& Values)
+		{
+			const FDodgerSampleSummary Summary = FDodgerSampleSummary::Make(Values);
+			Lines.Add(FString::Printf(TEXT("%s,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f"), *PhaseName, Metric, Summary.Count, Summary.Average,
+				Summary.P50, Summary.P90, Summary.P95, Summary.P99, Summary.Max));
+		};
+		AddPercentiles(TEXT("FrameTime"), Samples.FrameTimes);
+		AddPercentiles(TEXT("GameThreadTime"), Samples.GameThreadTimes);
+
+		// Systems only have totals - average per frame and longest single call
+		const int32 NumFrames = FMath::Max(Samples.FrameTimes.Num(), 1);
+		for (const TPair<FString, double>& SystemTime : Samples.SystemTimes)
+		{
+			Lines.Add(FString::Printf(TEXT("%s,%s,%d,%.3f,,,,,%.3f"), *PhaseName, *SystemTime.Key, Samples.FrameTimes.Num(),
+				SystemTime.Value * 1000.0 / NumFrames, Samples.SystemMaxTimes.FindRef(SystemTime.Key) * 1000.0));
+		}
+	}
+
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(DodgerStressTestLog, Display, TEXT("%s"), *Line);
+	}
+
+	const FString Directory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("StressTest"));
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	const FString FileName = FPaths::Combine(Directory, FString::Printf(TEXT("StressTest-%s.csv"), *FDateTime::Now().ToString()));
+	if (FFileHelper::SaveStringArrayToFile(Lines, *FileName))
+	{
+		UE_LOG(DodgerStressTestLog, Log, TEXT("[%hs] Report written to %s."), __func__, *FileName);
+	}
+	else
+	{
+		UE_LOG(DodgerStressTestLog, Error, TEXT("[%hs] Failed to write report %s."), __func__, *FileName);
+	}
+}
+
+TStatId UDodgerStressTest::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDodgerStressTest, STATGROUP_Tickables);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DodgerBotController.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DodgerStressTest.generated.h"
+
+class UEnemySpawnTable;
+class UStressTestConfig;
+
+/**
+ * Headless large scale scenario measuring server frame time (created only with -DodgerStressTest).
+ * Spawns enemies (through UEnemySpawner) and bot players, runs them through idle/patrol, chase and combat
+ * phases for a fixed time, writes frame time percentiles and per system timings of every phase
+ * to the profiling directory and exits. Settings come from UStressTestConfig, overridable from command line:
+ *
+ *   DodgerServer <Map> -nullrhi -log -DodgerStressTest -StressEnemies=500 -StressBots=16 -StressDuration=180
+ */
+UCLASS()
+class DODGER_API UDodgerStressTest : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDodgerStressTest* Get(const UObject* WorldContext);
+	static bool IsRequested();
+	
+	// Base Interface Start
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPhaseSamples
+	{
+		TArray<float> FrameTimes;
+		TArray<float> GameThreadTimes;
+		TMap<FString, double> SystemTimes;
+		TMap<FString, double> SystemMaxTimes;
+	};
+	
+	void Start();
+	void SpawnBots(int32 Count);
+	bool FindSpawnLocation(FVector& OutLocation, FVector& OutOrigin) const;
+	void SetPhase(EDodgerBotPhase NewPhase);
+	void UpdateBotTargets();
+	void RecordFrame(float DeltaTime);
+	void CollectSystemTimes();
+	void WriteReport() const;
+	
+	UPROPERTY(Transient)
+	TObjectPtr<const UStressTestConfig> Config;
+	
+	UPROPERTY(Transient)
+	TObjectPtr<UEnemySpawnTable> SpawnTable;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ADodgerBotController>> Bots;
+
+	FPhaseSamples PhaseSamples[3];
+	
+	int32 NumEnemies = 0;
+	int32 NumBots = 0;
+	float Duration = 0.0f;
+	
+	bool bStarted = false;
+	bool bMeasuring = false;
+	bool bFinished = false;
+	EDodgerBotPhase Phase = EDodgerBotPhase::Idle;
+	double StartTime = 0.0;
+	double NextRetargetTime = 0.0;
+};
@@ -0,0 +1,64 @@
+
+#include "DodgerStressTimings.h"
+
+bool FDodgerStressTimings::bEnabled = false;
+
+namespace
+{
+	TMap<FString, FDodgerStressTimings::FEntry>& GetMutableEntries()
+	{
+		static TMap<FString, FDodgerStressTimings::FEntry> Entries;
+		return Entries;
+	}
+}
+
+void FDodgerStressTimings::Add(const TCHAR* Name, double Seconds)
+{
+	check(IsInGameThread());
+
+	FEntry& Entry = GetMutableEntries().FindOrAdd(Name);
+	Entry.TotalSeconds += Seconds;
+	Entry.MaxSeconds = FMath::Max(Entry.MaxSeconds, Seconds);
+	++Entry.NumCalls;
+}
+
+void FDodgerStressTimings::Reset()
+{
+	GetMutableEntries().Reset();
+}
+
+const TMap<FString, FDodgerStressTimings::FEntry>& FDodgerStressTimings::GetEntries()
+{
+	return GetMutableEntries();
+}
+
+FDodgerSampleSummary FDodgerSampleSummary::Make(TArray<float> Samples)
+{
+	FDodgerSampleSummary Summary;
+	if (Samples.IsEmpty())
+	{
+		return Summary;
+	}
+
+	Samples.Sort();
+	
+	auto Percentile = [&Samples](float Fraction)
+	{
+		return Samples[FMath::Clamp(FMath::CeilToInt32(Fraction * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+	};
+
+	double Sum = 0.0;
+	for (const float Sample : Samples)
+	{
+		Sum += Sample;
+	}
+
+	Summary.Count = Samples.Num();
+	Summary.Average = static_cast<float>(Sum / Samples.Num());
+	Summary.P50 = Percentile(0.5f);
+	Summary.P90 = Percentile(0.9f);
+	Summary.P95 = Percentile(0.95f);
+	Summary.P99 = Percentile(0.99f);
+	Summary.Max = Samples.Last();
+	return Summary;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Accumulated wall time of instrumented game systems, collected only while a stress test runs.
+ */
+class DODGER_API FDodgerStressTimings
+{
+public:
+	struct FEntry
+	{
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+		int32 NumCalls = 0;
+	};
+
+	static bool IsEnabled() { return bEnabled; }
+	static void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
+	
+	static void Add(const TCHAR* Name, double Seconds);
+	static void Reset();
+	static const TMap<FString, FEntry>& GetEntries();
+
+private:
+	static bool bEnabled;
+};
+
+/**
+ * Average, percentiles and maximum of a series of samples (e.g. frame times in ms), used by stress and soak test reports.
+ */
+struct DODGER_API FDodgerSampleSummary
+{
+	int32 Count = 0;
+	float Average = 0.0f;
+	float P50 = 0.0f;
+	float P90 = 0.0f;
+	float P95 = 0.0f;
+	float P99 = 0.0f;
+	float Max = 0.0f;
+
+	static FDodgerSampleSummary Make(TArray<float> Samples);
+};
+
+/**
+ * Adds duration of the scope to FDodgerStressTimings (game thread only).
+ */
+struct FDodgerStressTimingScope
+{
+	explicit FDodgerStressTimingScope(const TCHAR* InName)
+		: Name(InName)
+		, StartTime(FDodgerStressTimings::IsEnabled() ? FPlatformTime::Seconds() : 0.0)
+	{
+	}
+
+	~FDodgerStressTimingScope()
+	{
+		if (StartTime > 0.0)
+		{
+			FDodgerStressTimings::Add(Name, FPlatformTime::Seconds() - StartTime);
+		}
+	}
+
+private:
+	const TCHAR* Name;
+	double StartTime;
+};
+
+#define DODGER_STRESS_TIMING_SCOPE(Name) FDodgerStressTimingScope ANONYMOUS_VARIABLE(StressTimingScope)(TEXT(Name))
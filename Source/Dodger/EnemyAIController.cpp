@@ -1,41 +1,33 @@
 
 #include "EnemyAIController.h"
+#include "DodgerCharacter.h"
+#include "DodgerDormancyManager.h"
+#include "DodgerStats.h"
+#include "EnemyAIManager.h"
+#include "FlowFieldManager.h"
+#include "StimulusManager.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "NavigationSystem.h"
 #include "Data/EnemyConfig.h"
 #include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Navigation/PathFollowingComponent.h"
-#include "Perception/AIPerceptionComponent.h"
-#include "Perception/AISenseConfig_Hearing.h"
-#include "Perception/AISenseConfig_Sight.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarAIDebugDraw(
+		TEXT("Dodger.AI.DebugDraw"),
+		false,
+		TEXT("Draw enemy AI state above enemies on their updates."));
+}
 
 AEnemyAIController::AEnemyAIController()
 {
+	// Actor tick only updates focus/control rotation, state machine runs in UEnemyAIManager
 	PrimaryActorTick.bCanEverTick = true;
 
 	Config = GetDefault<UEnemyConfig>();
-	
-	PerceptionComponent = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("PerceptionComponent"));
-	PerceptionComponent->OnTargetPerceptionUpdated.AddDynamic(this, &AEnemyAIController::OnTargetPerceptionUpdated);
-
-	// apply sensing config
-	if (Config->AISenseConfig)
-	{
-		PerceptionComponent->ConfigureSense(*Config->AISenseConfig);
-		PerceptionComponent->SetDominantSense(Config->AISenseConfig->GetSenseImplementation());
-	}
-	else
-	{
-		// Configure hearing
-		UAISenseConfig_Hearing* FallbackHearingConfig = CreateDefaultSubobject<UAISenseConfig_Hearing>(TEXT("Config_Hearing"));
-		FallbackHearingConfig->HearingRange = Config->ChaseStartDistance + 20.0f;
-		FallbackHearingConfig->DetectionByAffiliation.bDetectEnemies = true;
-		FallbackHearingConfig->DetectionByAffiliation.bDetectNeutrals = true;
-		FallbackHearingConfig->DetectionByAffiliation.bDetectFriendlies = true;
-		PerceptionComponent->ConfigureSense(*FallbackHearingConfig);
-		PerceptionComponent->SetDominantSense(FallbackHearingConfig->GetSenseImplementation());
-	}
 }
 
 void AEnemyAIController::OnPossess(APawn* InPawn)
@@ -45,66 +37,173 @@ void AEnemyAIController::OnPossess(APawn* InPawn)
 	// cache combat interface
 	CombatCharacter = TWeakInterfacePtr<IDodgerCombatInterface>(InPawn);
 	
-	// set initial position for patrolling around
+	// set initial position for patrolling around, cache gets filled around it by the AI manager
 	BaseLocation = InPawn->GetActorLocation();
+	PatrolPointCache.SetNumUninitialized(FMath::Max(Config->PatrolPointCacheSize, 1));
+	PatrolPointHead = 0;
+	NumPatrolPoints = 0;
 	
 	// apply custom color
 	if (GetCharacter() && GetCharacter()->GetMesh())
 	{
-		for (int32 MatIdx = 0; MatIdx < GetCharacter()->GetMesh()->GetNumMaterials(); ++MatIdx)
+		USkeletalMeshComponent* Mesh = GetCharacter()->GetMesh();
+		if (Config->bUseCustomPrimitiveDataTint)
 		{
-			GetCharacter()->GetMesh()->CreateDynamicMaterialInstance(MatIdx)->SetVectorParameterValue(Config->ColorParamName, Config->EnemyColor);
+			// keeps the shared material - no MID allocation, batching preserved
+			Mesh->SetCustomPrimitiveDataVector4(Config->TintCustomDataIndex, FVector4(Config->EnemyColor));
+		}
+		else
+		{
+			LLM_SCOPE_BYTAG(Dodger_Materials);
+			for (int32 MatIdx = 0; MatIdx < Mesh->GetNumMaterials(); ++MatIdx)
+			{
+				Mesh->CreateDynamicMaterialInstance(MatIdx)->SetVectorParameterValue(Config->ColorParamName, Config->EnemyColor);
+			}
 		}
 	}
 	
+	// State machine data and updates are owned by the AI manager
+	FEnemyDecisionParams DecisionParams;
+	DecisionParams.AttackRangeSq = FMath::Square(Config->AttackRange);
+	DecisionParams.AttackRangeWithOffsetSq = FMath::Square(Config->AttackRange + Config->AttackRangeOffset);
+	DecisionParams.ChaseStopDistanceSq = FMath::Square(Config->ChaseStopDistance);
+
+	UEnemyAIManager* AIManager = UEnemyAIManager::Get(this);
+	DecisionCore = &AIManager->GetDecisionCore();
+	DecisionSlot = AIManager->RegisterController(this, DecisionParams);
+	
 	SetState(EEnemyState::Idle);
 }
 
-void AEnemyAIController::Tick(float DeltaTime)
+void AEnemyAIController::OnUnPossess()
+{
+	if (UEnemyAIManager* AIManager = UEnemyAIManager::Get(this))
+	{
+		AIManager->UnregisterController(this);
+	}
+	if (UFlowFieldManager* FlowFieldManager = UFlowFieldManager::Get(this))
+	{
+		FlowFieldManager->StopFollowing(this);
+	}
+	DecisionCore = nullptr;
+	DecisionSlot = INDEX_NONE;
+
+	Super::OnUnPossess();
+}
+
+void AEnemyAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyAIManager* AIManager = UEnemyAIManager::Get(this))
+	{
+		AIManager->UnregisterController(this);
+	}
+	if (UFlowFieldManager* FlowFieldManager = UFlowFieldManager::Get(this))
+	{
+		FlowFieldManager->StopFollowing(this);
+	}
+	DecisionCore = nullptr;
+	DecisionSlot = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+EEnemyState AEnemyAIController::GetState() const
 {
-	Super::Tick(DeltaTime);
+	return HasDecisionSlot() ? DecisionCore->States[DecisionSlot] : EEnemyState::None;
+}
 
-	if (CombatCharacter.IsValid() && CombatCharacter->GetHealth() > 0.0f)
+bool AEnemyAIController::GatherDecisionInputs(FEnemyDecisionCore& Core, float DeltaTime)
+{
+	const APawn* ControlledPawn = GetPawn();
+	if (!ControlledPawn || !CombatCharacter.IsValid() || CombatCharacter->GetHealth() <= 0.0f)
 	{
-		UpdateStates(DeltaTime);
-
-		{ // debug
-			static const TMap<EEnemyState, FString> StateToStringMap = {
-				{EEnemyState::Idle, "Idle"},
-				{EEnemyState::Patrol, "Patrol"},
-				{EEnemyState::Chase, "Chase"},
-				{EEnemyState::Combat, "Attack"},
-			};
-		
-			DrawDebugString(GetWorld(), FVector(0,-20,150),
-				FString::Printf(TEXT("AI State: %s"),
-				*StateToStringMap[CurrentState]),
-				GetPawn(), FColor::Green, 0, true);
-		}
+		return false;
+	}
+
+	ProcessStimuli();
+
+	AActor* Target = Core.Targets[DecisionSlot].Get();
+	uint8 Flags = 0;
+	if (IsTargetValidEnemy(Target))
+	{
+		Flags |= FEnemyDecisionCore::Input_TargetValid;
+	}
+	if (GetMoveStatus() == EPathFollowingStatus::Idle)
+	{
+		Flags |= FEnemyDecisionCore::Input_MoveIdle;
+	}
+
+	Core.SetInputs(DecisionSlot, DeltaTime, ControlledPawn->GetActorLocation(), Target ? Target->GetActorLocation() : FVector::ZeroVector, Flags);
+	return true;
+}
+
+void AEnemyAIController::ApplyDecision(const FEnemyDecision& Decision)
+{
+	if (Decision.bClearTarget)
+	{
+		SetFollowTarget(nullptr);
+	}
+	SetState(Decision.NewState);
+
+	if (CVarAIDebugDraw.GetValueOnGameThread())
+	{
+		static const TMap<EEnemyState, FString> StateToStringMap = {
+			{EEnemyState::Idle, "Idle"},
+			{EEnemyState::Patrol, "Patrol"},
+			{EEnemyState::Chase, "Chase"},
+			{EEnemyState::Combat, "Attack"},
+		};
+
+		// Visible until the next update of this enemy
+		const float Duration = GetUpdateInterval(0.0f);
+		DrawDebugString(GetWorld(), FVector(0,-20,150),
+			FString::Printf(TEXT("AI State: %s"),
+			*StateToStringMap[GetState()]),
+			GetPawn(), FColor::Green, Duration, true);
+	}
+}
+
+float AEnemyAIController::GetUpdateInterval(float NearestPlayerDistSquared) const
+{
+	const float DistanceAlpha = FMath::GetRangePct(Config->FullRateDistance, Config->MinRateDistance, FMath::Sqrt(NearestPlayerDistSquared));
+	const float Alpha = FMath::Clamp(DistanceAlpha, 0.0f, 1.0f);
+
+	switch (GetState())
+	{
+	case EEnemyState::Combat:
+		return 0.0f;
+	case EEnemyState::Chase:
+		return FMath::Lerp(Config->ChaseUpdateInterval.X, Config->ChaseUpdateInterval.Y, Alpha);
+	default:
+		return FMath::Lerp(Config->IdleUpdateInterval.X, Config->IdleUpdateInterval.Y, Alpha);
 	}
 }
 
 void AEnemyAIController::OnStateEnter(EEnemyState NewState, EEnemyState OldState)
 {
-	StateTimeElapsed = 0.0f;
+	DecisionCore->StateTimeElapsed[DecisionSlot] = 0.0f;
 	
 	switch (NewState)
 	{
 	case EEnemyState::Idle:
-		TimeToExitIdle = FMath::FRandRange(Config->RandomIdleTime.X, Config->RandomIdleTime.Y);
+		DecisionCore->TimeToExitIdle[DecisionSlot] = FMath::FRandRange(Config->RandomIdleTime.X, Config->RandomIdleTime.Y);
 		break;
 	case EEnemyState::Patrol:
 		GetCharacter()->GetCharacterMovement()->MaxWalkSpeed = Config->PatrolWalkSpeed;
-		FindPatrolPoint(CurrentPatrolLocation);
+		// cache empty (e.g. right after spawn) - query directly
+		if (!PopPatrolPoint(CurrentPatrolLocation))
+		{
+			FindPatrolPoint(CurrentPatrolLocation);
+		}
 		MoveToLocation(CurrentPatrolLocation);
 		break;
 	case EEnemyState::Chase:
 		GetCharacter()->GetCharacterMovement()->MaxWalkSpeed = Config->ChaseWalkSpeed;
-		MoveToActor(TargetActor.Get());
+		UFlowFieldManager::Get(this)->StartFollowing(this, GetTargetActor());
 		break;
 	case EEnemyState::Combat:
 		GetCharacter()->GetCharacterMovement()->MaxWalkSpeed = 10.0f; //small speed to allow auto rotation
-		MoveToActor(TargetActor.Get());
+		UFlowFieldManager::Get(this)->StartFollowing(this, GetTargetActor());
 		CombatCharacter->SetFireIntent(true);
 		break;
 	}
@@ -121,40 +220,28 @@ void AEnemyAIController::OnStateExit(EEnemyState State, EEnemyState NextState)
 		StopMovement();
 		break;
 	case EEnemyState::Chase:
+		UFlowFieldManager::Get(this)->StopFollowing(this);
 		StopMovement();
-		ForcedChaseTimer = 0.0f;
+		DecisionCore->ForcedChaseTimer[DecisionSlot] = 0.0f;
 		break;
 	case EEnemyState::Combat:
+		UFlowFieldManager::Get(this)->StopFollowing(this);
 		CombatCharacter->SetFireIntent(false);
 		break;
 	}
 }
 
-void AEnemyAIController::UpdateStates(float DeltaTime)
-{
-	StateTimeElapsed += DeltaTime;
-	
-	switch (CurrentState)
-	{
-	case EEnemyState::Idle:
-		UpdateIdle(DeltaTime);
-		break;
-	case EEnemyState::Patrol:
-		UpdatePatrol(DeltaTime);
-		break;
-	case EEnemyState::Chase:
-		UpdateChase(DeltaTime);
-		break;
-	case EEnemyState::Combat:
-		UpdateCombat(DeltaTime);
-		break;
-	}
-}
-
 void AEnemyAIController::SetState(EEnemyState NewState)
 {
+	EEnemyState& CurrentState = DecisionCore->States[DecisionSlot];
 	if (CurrentState != NewState)
 	{
+		// Leaving Idle means moving and fighting soon
+		if (UDodgerDormancyManager* DormancyManager = UDodgerDormancyManager::Get(this))
+		{
+			DormancyManager->WakeCharacter(Cast<ADodgerCharacter>(GetPawn()));
+		}
+
 		OnStateExit(CurrentState, NewState);
 		EEnemyState OldState = CurrentState;
 		CurrentState = NewState;
@@ -162,102 +249,35 @@ void AEnemyAIController::SetState(EEnemyState NewState)
 	}
 }
 
-void AEnemyAIController::UpdateIdle(float DeltaTime)
-{
-	if (HasValidEnemy())
-	{
-		SetState(EEnemyState::Chase);
-		return;
-	}
-	
-	if (TimeToExitIdle > StateTimeElapsed)
-	{
-		SetState(EEnemyState::Patrol);
-	}
-}
-
-void AEnemyAIController::UpdatePatrol(float DeltaTime)
-{
-	if (HasValidEnemy())
-	{
-		SetState(EEnemyState::Chase);
-		return;
-	}
-
-	// stopped movement - go to idle to decide next step
-	if (GetMoveStatus() == EPathFollowingStatus::Idle)
-	{
-		SetState(EEnemyState::Idle);
-	}
-}
-
-void AEnemyAIController::UpdateChase(float DeltaTime)
+void AEnemyAIController::ProcessStimuli()
 {
-	// Enemy lost - go to idle
-	if (!HasValidEnemy())
-	{
-		SetState(EEnemyState::Idle);
-		return;
-	}
+	LLM_SCOPE_BYTAG(Dodger_Perception);
 	
-	const float DistToTarget = GetPawn()->GetSquaredDistanceTo(TargetActor.Get());
-
-	// Reached Attack range - go to attack state
-	if (DistToTarget < FMath::Square(Config->AttackRange))
-	{
-		SetState(EEnemyState::Combat);
-		return;
-	}
-
-	if ((ForcedChaseTimer -= DeltaTime) <= 0.0f)
-	{
-		// Player got too far - go back to idle/patrol
-		if (DistToTarget > FMath::Square(Config->ChaseStopDistance))
-		{
-			SetFollowTarget(nullptr);
-			SetState(EEnemyState::Idle);
-		}
-	}
-}
-
-void AEnemyAIController::UpdateCombat(float DeltaTime)
-{
-	if (!HasValidEnemy())
+	const UStimulusManager* StimulusManager = UStimulusManager::Get(this);
+	if (!StimulusManager || !GetCharacter())
 	{
-		SetState(EEnemyState::Idle);
 		return;
 	}
 
-	const float DistToTarget = GetPawn()->GetSquaredDistanceTo(TargetActor.Get());
-	
-	// Enemy got too far, approach - chase again
-	if (DistToTarget > FMath::Square(Config->AttackRange + Config->AttackRangeOffset))
-	{
-		SetState(EEnemyState::Chase);
-		return;
-	}
+	SensedStimuli.Reset();
+	StimulusManager->QueryStimuli(GetCharacter()->GetActorLocation(), Config->ChaseStartDistance, GetCharacter(), SensedStimuli);
 
-	// Player got too far - go back to idle/patrol
-	if (DistToTarget > FMath::Square(Config->ChaseStopDistance))
+	for (const FDodgerStimulus& Stimulus : SensedStimuli)
 	{
-		SetFollowTarget(nullptr);
-		SetState(EEnemyState::Idle);
+		HandleStimulus(Stimulus);
 	}
 }
 
-void AEnemyAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
+void AEnemyAIController::HandleStimulus(const FDodgerStimulus& Stimulus)
 {
-	if (!Stimulus.WasSuccessfullySensed())
-	{
-		return;
-	}
+	AActor* Actor = Stimulus.Source.Get();
 	
 	if (!GetCharacter() || Actor == GetCharacter())
 	{
 		return;
 	}
 	
-	if (Actor == TargetActor)
+	if (!HasDecisionSlot() || Actor == GetTargetActor())
 	{
 		return;
 	}
@@ -272,12 +292,12 @@ void AEnemyAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus St
 	{
 		SetFollowTarget(Actor);
 	}
-	else if (CurrentState == EEnemyState::Patrol)
+	else if (GetState() == EEnemyState::Patrol)
 	{
 		// force chase - could be a projectile caused the noise
-		if (FVector::Distance(Stimulus.StimulusLocation, GetCharacter()->GetActorLocation()) < Config->ChaseStartDistance)
+		if (FVector::Distance(Stimulus.Location, GetCharacter()->GetActorLocation()) < Config->ChaseStartDistance)
 		{
-			ForcedChaseTimer = 5.0f;
+			DecisionCore->ForcedChaseTimer[DecisionSlot] = 5.0f;
 			SetFollowTarget(Actor);
 		}
 	}
@@ -300,6 +320,39 @@ bool AEnemyAIController::FindPatrolPoint(FVector& OutPatrolPoint) const
 	return false;
 }
 
+bool AEnemyAIController::PopPatrolPoint(FVector& OutPatrolPoint)
+{
+	if (NumPatrolPoints == 0)
+	{
+		return false;
+	}
+
+	OutPatrolPoint = PatrolPointCache[PatrolPointHead];
+	PatrolPointHead = (PatrolPointHead + 1) % PatrolPointCache.Num();
+	--NumPatrolPoints;
+	return true;
+}
+
+bool AEnemyAIController::NeedsPatrolPoints() const
+{
+	return NumPatrolPoints < PatrolPointCache.Num();
+}
+
+void AEnemyAIController::RefillPatrolPoint()
+{
+	FVector PatrolPoint;
+	if (NeedsPatrolPoints() && FindPatrolPoint(PatrolPoint))
+	{
+		PatrolPointCache[(PatrolPointHead + NumPatrolPoints) % PatrolPointCache.Num()] = PatrolPoint;
+		++NumPatrolPoints;
+	}
+}
+
+SIZE_T AEnemyAIController::GetAllocatedSize() const
+{
+	return PatrolPointCache.GetAllocatedSize() + SensedStimuli.GetAllocatedSize();
+}
+
 bool AEnemyAIController::IsTargetValidEnemy(AActor* Actor) const
 {
 	if (!Actor)
@@ -315,18 +368,23 @@ bool AEnemyAIController::IsTargetValidEnemy(AActor* Actor) const
 	return false;
 }
 
-bool AEnemyAIController::HasValidEnemy() const
-{
-	return IsTargetValidEnemy(TargetActor.Get());
-}
-
 
 void AEnemyAIController::SetFollowTarget(AActor* Target)
 {
-	TargetActor = Target;
+	if (HasDecisionSlot())
+	{
+		DecisionCore->Targets[DecisionSlot] = Target;
+
+		// switched target while chasing - follow the new one
+		const EEnemyState State = GetState();
+		if (Target && (State == EEnemyState::Chase || State == EEnemyState::Combat))
+		{
+			UFlowFieldManager::Get(this)->StartFollowing(this, Target);
+		}
+	}
 }
 
 AActor* AEnemyAIController::GetTargetActor() const
 {
-	return TargetActor.Get();	
+	return HasDecisionSlot() ? DecisionCore->Targets[DecisionSlot].Get() : nullptr;	
 }
@@ -2,24 +2,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Perception/AIPerceptionTypes.h"
 #include "Runtime/AIModule/Classes/AIController.h"
 #include "UObject/WeakInterfacePtr.h"
 #include "Interfaces/DodgerCombatInterface.h"
+#include "EnemyDecisionCore.h"
+#include "StimulusManager.h"
 #include "EnemyAIController.generated.h"
 
 class UEnemyConfig;
-class UAIPerceptionComponent;
-class UAISenseConfig_Hearing;
-
-enum class EEnemyState : uint8
-{
-	None,
-	Idle,
-	Patrol,
-	Chase,
-	Combat,
-};
 
 UCLASS()
 class DODGER_API AEnemyAIController : public AAIController
@@ -33,11 +23,36 @@ public:
 	void SetFollowTarget(AActor* Target);
 	
 	AActor* GetTargetActor() const;
+	
+	EEnemyState GetState() const;
+	
+	/**
+	 * Write this frame's decision inputs into the core, returns false if there is nothing to decide
+	 */
+	bool GatherDecisionInputs(FEnemyDecisionCore& Core, float DeltaTime);
+	/**
+	 * Apply state transition evaluated by the decision core
+	 */
+	void ApplyDecision(const FEnemyDecision& Decision);
+	/**
+	 * Time until the next state machine update based on state and distance to nearest player
+	 */
+	float GetUpdateInterval(float NearestPlayerDistSquared) const;
+	/**
+	 * Patrol point cache - refilled by UEnemyAIManager a few navmesh queries per frame
+	 */
+	bool NeedsPatrolPoints() const;
+	void RefillPatrolPoint();
+	/**
+	 * Memory owned by patrol cache and sensed stimuli (see UDodgerMemoryTracker)
+	 */
+	SIZE_T GetAllocatedSize() const;
 
 protected:
 	// Base Class Interface Start
-	virtual void Tick(float DeltaTime) override;
 	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	// Base Class Interface End
 
 	virtual void OnStateEnter(EEnemyState NewState, EEnemyState OldState);
@@ -47,34 +62,34 @@ private:
 
 	// State functions
 	void SetState(EEnemyState NewState);
-	void UpdateIdle(float DeltaTime);
-	void UpdateStates(float DeltaTime);
-	void UpdatePatrol(float DeltaTime);
-	void UpdateChase(float DeltaTime);
-	void UpdateCombat(float DeltaTime);
 
-	// Perception callbacks
-	UFUNCTION()
-	void OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus);
+	// Perception
+	void ProcessStimuli();
+	void HandleStimulus(const FDodgerStimulus& Stimulus);
 	
 	// Helpers
 	bool FindPatrolPoint(FVector& OutPatrolPoint) const;
+	bool PopPatrolPoint(FVector& OutPatrolPoint);
 	bool IsTargetValidEnemy(AActor* Actor) const;
-	bool HasValidEnemy() const;
+	bool HasDecisionSlot() const { return DecisionCore && DecisionSlot != INDEX_NONE; }
 	
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, NoClear, meta=(AllowPrivateAccess))
 	TObjectPtr<const UEnemyConfig> Config;
 	
-	TWeakObjectPtr<AActor> TargetActor;
-	
 	FVector BaseLocation = FVector::ZeroVector;
 	FVector CurrentPatrolLocation = FVector::ZeroVector;
-	
-	EEnemyState CurrentState = EEnemyState::None;
 
-	float StateTimeElapsed = 0.0f;
-	float TimeToExitIdle = 0.0f;
-	float ForcedChaseTimer = 0.0f;
+	// Ring buffer of reachable points around BaseLocation
+	TArray<FVector> PatrolPointCache;
+	int32 PatrolPointHead = 0;
+	int32 NumPatrolPoints = 0;
+	
+	// State machine data lives in the AI manager's decision core (state, timers, target)
+	FEnemyDecisionCore* DecisionCore = nullptr;
+	int32 DecisionSlot = INDEX_NONE;
 	
 	TWeakInterfacePtr<IDodgerCombatInterface> CombatCharacter = nullptr;
+
+	// Stimulus query scratch
+	TArray<FDodgerStimulus> SensedStimuli;
 };
@@ -0,0 +1,262 @@
+
+#include "EnemyAIManager.h"
+
+#include "DodgerStats.h"
+#include "DodgerStressTimings.h"
+#include "EnemyAIController.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarAIUpdateBudgetMs(
+		TEXT("Dodger.AI.UpdateBudgetMs"),
+		2.0f,
+		TEXT("Time budget (ms) per frame for enemy AI updates. Enemies in combat always update."));
+
+	TAutoConsoleVariable<int32> CVarAIPatrolQueriesPerFrame(
+		TEXT("Dodger.AI.PatrolQueriesPerFrame"),
+		4,
+		TEXT("Number of navmesh queries per frame used to refill enemy patrol point caches."));
+
+	// Smoothing of the measured per enemy update cost
+	constexpr double UpdateCostSmoothing = 0.1;
+}
+
+UEnemyAIManager* UEnemyAIManager::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UEnemyAIManager>();
+	}
+
+	return nullptr;
+}
+
+bool UEnemyAIManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UEnemyAIManager::RegisterController(AEnemyAIController* Controller, const FEnemyDecisionParams& Params)
+{
+	LLM_SCOPE_BYTAG(Dodger_AI);
+	
+	if (!Controller)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const FUpdateEntry* Existing = Entries.FindByPredicate([Controller](const FUpdateEntry& Entry) { return Entry.Controller == Controller; }))
+	{
+		return Existing->Slot;
+	}
+
+	FUpdateEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Controller = Controller;
+	Entry.Slot = DecisionCore.AllocateSlot(Params);
+	Entry.LastUpdateTime = GetWorld()->GetTimeSeconds();
+	Entry.NextUpdateTime = Entry.LastUpdateTime;
+
+	return Entry.Slot;
+}
+
+void UEnemyAIManager::UnregisterController(AEnemyAIController* Controller)
+{
+	const int32 Index = Entries.IndexOfByPredicate([Controller](const FUpdateEntry& Entry) { return Entry.Controller == Controller; });
+	if (Index != INDEX_NONE)
+	{
+		DecisionCore.ReleaseSlot(Entries[Index].Slot);
+		Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void UEnemyAIManager::RequestImmediateUpdate(AEnemyAIController* Controller)
+{
+	if (FUpdateEntry* Entry = Entries.FindByPredicate([Controller](const FUpdateEntry& Entry) { return Entry.Controller == Controller; }))
+	{
+		Entry->NextUpdateTime = 0.0;
+	}
+}
+
+void UEnemyAIManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerAIUpdate);
+	LLM_SCOPE_BYTAG(Dodger_AI);
+	DODGER_STRESS_TIMING_SCOPE("EnemyAI");
+
+	// Drop controllers destroyed without unregistering
+	Entries.RemoveAllSwap([this](const FUpdateEntry& Entry)
+	{
+		if (!Entry.Controller.IsValid())
+		{
+			DecisionCore.ReleaseSlot(Entry.Slot);
+			return true;
+		}
+		return false;
+	}, EAllowShrinking::No);
+
+	if (Entries.IsEmpty())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	GatherPlayerLocations();
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	DueEntries.Reset();
+	DueSlots.Reset();
+
+	{
+		DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerAIGather);
+
+		// Enemies in combat react every frame regardless of budget
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			if (Entries[Index].Controller->GetState() == EEnemyState::Combat && GatherEntry(Entries[Index], Now))
+			{
+				DueEntries.Add(Index);
+			}
+		}
+
+		// Remaining due enemies round robin, as many as fit into the budget at the measured cost per update
+		const double Budget = CVarAIUpdateBudgetMs.GetValueOnGameThread() * 0.001;
+		const int32 MaxBudgetedUpdates = AverageUpdateCost > 0.0 ? FMath::Max(1, FMath::FloorToInt32(Budget / AverageUpdateCost)) : Entries.Num();
+	
+		const int32 NumEntries = Entries.Num();
+		Cursor = Cursor % NumEntries;
+		int32 Visited = 0;
+		int32 NumBudgeted = 0;
+		for (; Visited < NumEntries && NumBudgeted < MaxBudgetedUpdates; ++Visited)
+		{
+			const int32 Index = (Cursor + Visited) % NumEntries;
+			FUpdateEntry& Entry = Entries[Index];
+			if (Entry.LastUpdateTime == Now || Now < Entry.NextUpdateTime)
+			{
+				continue;
+			}
+
+			if (GatherEntry(Entry, Now))
+			{
+				DueEntries.Add(Index);
+				++NumBudgeted;
+			}
+		}
+		Cursor = (Cursor + Visited) % NumEntries;
+	}
+
+	for (const int32 Index : DueEntries)
+	{
+		DueSlots.Add(Entries[Index].Slot);
+	}
+
+	DODGER_INC_COUNTER(STAT_DodgerAIUpdates, DueEntries.Num());
+
+	// Transitions only touch slot data - safe to run wide
+	{
+		DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerAIEvaluate);
+		DecisionCore.Evaluate(DueSlots);
+	}
+
+	// Movement, focus and combat intent changes need actors - back on game thread
+	{
+		DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerAIApply);
+		for (const int32 Index : DueEntries)
+		{
+			ApplyEntry(Entries[Index], Now);
+		}
+	}
+
+	if (DueEntries.Num() > 0)
+	{
+		const double CostPerUpdate = (FPlatformTime::Seconds() - StartTime) / DueEntries.Num();
+		AverageUpdateCost = AverageUpdateCost > 0.0 ? FMath::Lerp(AverageUpdateCost, CostPerUpdate, UpdateCostSmoothing) : CostPerUpdate;
+	}
+
+	RefillPatrolPoints();
+}
+
+void UEnemyAIManager::RefillPatrolPoints()
+{
+	// Navmesh queries are not safe against tiles being rebuilt, so they stay on game thread
+	// but are spread across frames instead of happening when an enemy enters Patrol
+	const int32 NumEntries = Entries.Num();
+	int32 QueriesLeft = CVarAIPatrolQueriesPerFrame.GetValueOnGameThread();
+	PatrolRefillCursor = PatrolRefillCursor % NumEntries;
+	for (int32 Visited = 0; Visited < NumEntries && QueriesLeft > 0; ++Visited)
+	{
+		AEnemyAIController* Controller = Entries[PatrolRefillCursor].Controller.Get();
+		PatrolRefillCursor = (PatrolRefillCursor + 1) % NumEntries;
+
+		if (Controller->NeedsPatrolPoints())
+		{
+			Controller->RefillPatrolPoint();
+			--QueriesLeft;
+		}
+	}
+}
+
+bool UEnemyAIManager::GatherEntry(FUpdateEntry& Entry, double Now)
+{
+	const float DeltaTime = static_cast<float>(Now - Entry.LastUpdateTime);
+	Entry.LastUpdateTime = Now;
+
+	if (!Entry.Controller->GatherDecisionInputs(DecisionCore, DeltaTime))
+	{
+		// Nothing to decide (e.g. dead) - check again at the slowest rate
+		Entry.NextUpdateTime = Now + Entry.Controller->GetUpdateInterval(UE_BIG_NUMBER);
+		return false;
+	}
+
+	return true;
+}
+
+void UEnemyAIManager::ApplyEntry(FUpdateEntry& Entry, double Now)
+{
+	AEnemyAIController* Controller = Entry.Controller.Get();
+
+	Controller->ApplyDecision(DecisionCore.Decisions[Entry.Slot]);
+
+	const APawn* Pawn = Controller->GetPawn();
+	const float DistSq = Pawn ? GetNearestPlayerDistanceSquared(Pawn->GetActorLocation()) : UE_BIG_NUMBER;
+	Entry.NextUpdateTime = Now + Controller->GetUpdateInterval(DistSq);
+}
+
+void UEnemyAIManager::GatherPlayerLocations()
+{
+	// Any controller with a player state is a player - includes bots (e.g. ADodgerBotController)
+	PlayerLocations.Reset();
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		const AController* Controller = It->Get();
+		if (const APawn* Pawn = Controller && Controller->PlayerState ? Controller->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+}
+
+float UEnemyAIManager::GetNearestPlayerDistanceSquared(const FVector& Location) const
+{
+	float NearestDistSq = UE_BIG_NUMBER;
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		NearestDistSq = FMath::Min(NearestDistSq, static_cast<float>(FVector::DistSquared(Location, PlayerLocation)));
+	}
+
+	return NearestDistSq;
+}
+
+SIZE_T UEnemyAIManager::GetAllocatedSize() const
+{
+	return Entries.GetAllocatedSize() + PlayerLocations.GetAllocatedSize() + DueEntries.GetAllocatedSize()
+		+ DueSlots.GetAllocatedSize() + DecisionCore.GetAllocatedSize();
+}
+
+TStatId UEnemyAIManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAIManager, STATGROUP_Tickables);
+}
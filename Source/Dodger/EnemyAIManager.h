@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyDecisionCore.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyAIManager.generated.h"
+
+class AEnemyAIController;
+
+/**
+ * Owns enemy AI updates (server only).
+ * Controllers are time-sliced across frames within a per frame budget, their update rate
+ * scales with distance to the nearest player and current state.
+ * Each update gathers inputs on game thread, evaluates state transitions of all due enemies
+ * in parallel on FEnemyDecisionCore and applies the results back on game thread.
+ * Patrol point caches of the controllers are refilled a few navmesh queries per frame.
+ */
+UCLASS()
+class DODGER_API UEnemyAIManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEnemyAIManager* Get(const UObject* WorldContext);
+	/**
+	 *  Start/stop updating controller, returns decision slot owned by the controller
+	 */
+	int32 RegisterController(AEnemyAIController* Controller, const FEnemyDecisionParams& Params);
+	void UnregisterController(AEnemyAIController* Controller);
+	/**
+	 *  Force controller to update on the next frame (e.g. perceived new target)
+	 */
+	void RequestImmediateUpdate(AEnemyAIController* Controller);
+
+	FEnemyDecisionCore& GetDecisionCore() { return DecisionCore; }
+	/**
+	 *  Memory owned by the manager including decision core (see UDodgerMemoryTracker)
+	 */
+	SIZE_T GetAllocatedSize() const;
+	
+	// Base Interface Start
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	
+private:
+	struct FUpdateEntry
+	{
+		TWeakObjectPtr<AEnemyAIController> Controller;
+		int32 Slot = INDEX_NONE;
+		double LastUpdateTime = 0.0;
+		double NextUpdateTime = 0.0;
+	};
+	
+	void GatherPlayerLocations();
+	float GetNearestPlayerDistanceSquared(const FVector& Location) const;
+	bool GatherEntry(FUpdateEntry& Entry, double Now);
+	void ApplyEntry(FUpdateEntry& Entry, double Now);
+	void RefillPatrolPoints();
+	
+	TArray<FUpdateEntry> Entries;
+	TArray<FVector> PlayerLocations;
+
+	FEnemyDecisionCore DecisionCore;
+
+	// Per frame scratch - entries updated this frame and their decision slots
+	TArray<int32> DueEntries;
+	TArray<int32> DueSlots;
+
+	// Moving average of the game thread cost of one enemy update, used to fit updates into budget
+	double AverageUpdateCost = 0.0;
+	
+	// Round robin position - where the budget ran out last frame
+	int32 Cursor = 0;
+
+	// Round robin position of patrol point refills
+	int32 PatrolRefillCursor = 0;
+};
@@ -0,0 +1,176 @@
+
+#include "EnemyDecisionCore.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// Transitions are a handful of compares - avoid task overhead for small batches
+	constexpr int32 MinSlotsPerTask = 64;
+}
+
+int32 FEnemyDecisionCore::AllocateSlot(const FEnemyDecisionParams& InParams)
+{
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		SlotUsed[Slot] = true;
+	}
+	else
+	{
+		Slot = SlotUsed.Add(true);
+		States.AddDefaulted();
+		StateTimeElapsed.AddDefaulted();
+		TimeToExitIdle.AddDefaulted();
+		ForcedChaseTimer.AddDefaulted();
+		Targets.AddDefaulted();
+		Params.AddDefaulted();
+		DeltaTimes.AddDefaulted();
+		PawnLocations.AddDefaulted();
+		TargetLocations.AddDefaulted();
+		InputFlags.AddDefaulted();
+		Decisions.AddDefaulted();
+	}
+
+	States[Slot] = EEnemyState::None;
+	StateTimeElapsed[Slot] = 0.0f;
+	TimeToExitIdle[Slot] = 0.0f;
+	ForcedChaseTimer[Slot] = 0.0f;
+	Targets[Slot] = nullptr;
+	Params[Slot] = InParams;
+	Decisions[Slot] = FEnemyDecision();
+
+	return Slot;
+}
+
+void FEnemyDecisionCore::ReleaseSlot(int32 Slot)
+{
+	if (IsValidSlot(Slot))
+	{
+		SlotUsed[Slot] = false;
+		Targets[Slot] = nullptr;
+		FreeSlots.Add(Slot);
+	}
+}
+
+void FEnemyDecisionCore::SetInputs(int32 Slot, float DeltaTime, const FVector& PawnLocation, const FVector& TargetLocation, uint8 Flags)
+{
+	DeltaTimes[Slot] = DeltaTime;
+	PawnLocations[Slot] = PawnLocation;
+	TargetLocations[Slot] = TargetLocation;
+	InputFlags[Slot] = Flags;
+}
+
+void FEnemyDecisionCore::Evaluate(TConstArrayView<int32> Slots)
+{
+	ParallelFor(TEXT("EnemyDecisions"), Slots.Num(), MinSlotsPerTask, [this, Slots](int32 Index)
+	{
+		EvaluateSlot(Slots[Index], *this);
+	});
+}
+
+SIZE_T FEnemyDecisionCore::GetAllocatedSize() const
+{
+	return States.GetAllocatedSize() + StateTimeElapsed.GetAllocatedSize() + TimeToExitIdle.GetAllocatedSize()
+		+ ForcedChaseTimer.GetAllocatedSize() + Targets.GetAllocatedSize() + Params.GetAllocatedSize()
+		+ DeltaTimes.GetAllocatedSize() + PawnLocations.GetAllocatedSize() + TargetLocations.GetAllocatedSize()
+		+ InputFlags.GetAllocatedSize() + Decisions.GetAllocatedSize() + SlotUsed.GetAllocatedSize() + FreeSlots.GetAllocatedSize();
+}
+
+void FEnemyDecisionCore::EvaluateSlot(int32 Slot, FEnemyDecisionCore& Core)
+{
+	const float DeltaTime = Core.DeltaTimes[Slot];
+	const uint8 Flags = Core.InputFlags[Slot];
+	const bool bTargetValid = (Flags & Input_TargetValid) != 0;
+	const FEnemyDecisionParams& SlotParams = Core.Params[Slot];
+	const EEnemyState State = Core.States[Slot];
+
+	FEnemyDecision& Decision = Core.Decisions[Slot];
+	Decision = FEnemyDecision();
+	Decision.NewState = State;
+
+	Core.StateTimeElapsed[Slot] += DeltaTime;
+
+	switch (State)
+	{
+	case EEnemyState::Idle:
+		if (bTargetValid)
+		{
+			Decision.NewState = EEnemyState::Chase;
+		}
+		else if (Core.TimeToExitIdle[Slot] > Core.StateTimeElapsed[Slot])
+		{
+			Decision.NewState = EEnemyState::Patrol;
+		}
+		break;
+
+	case EEnemyState::Patrol:
+		if (bTargetValid)
+		{
+			Decision.NewState = EEnemyState::Chase;
+		}
+		// stopped movement - go to idle to decide next step
+		else if (Flags & Input_MoveIdle)
+		{
+			Decision.NewState = EEnemyState::Idle;
+		}
+		break;
+
+	case EEnemyState::Chase:
+	{
+		// Enemy lost - go to idle
+		if (!bTargetValid)
+		{
+			Decision.NewState = EEnemyState::Idle;
+			break;
+		}
+
+		const float DistToTarget = FVector::DistSquared(Core.PawnLocations[Slot], Core.TargetLocations[Slot]);
+
+		// Reached Attack range - go to attack state
+		if (DistToTarget < SlotParams.AttackRangeSq)
+		{
+			Decision.NewState = EEnemyState::Combat;
+			break;
+		}
+
+		// Player got too far - go back to idle/patrol
+		if ((Core.ForcedChaseTimer[Slot] -= DeltaTime) <= 0.0f && DistToTarget > SlotParams.ChaseStopDistanceSq)
+		{
+			Decision.bClearTarget = true;
+			Decision.NewState = EEnemyState::Idle;
+		}
+		break;
+	}
+
+	case EEnemyState::Combat:
+	{
+		if (!bTargetValid)
+		{
+			Decision.NewState = EEnemyState::Idle;
+			break;
+		}
+
+		const float DistToTarget = FVector::DistSquared(Core.PawnLocations[Slot], Core.TargetLocations[Slot]);
+
+		// Enemy got too far, approach - chase again
+		if (DistToTarget > SlotParams.AttackRangeWithOffsetSq)
+		{
+			Decision.NewState = EEnemyState::Chase;
+			break;
+		}
+
+		// Player got too far - go back to idle/patrol
+		if (DistToTarget > SlotParams.ChaseStopDistanceSq)
+		{
+			Decision.bClearTarget = true;
+			Decision.NewState = EEnemyState::Idle;
+		}
+		break;
+	}
+
+	default:
+		break;
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EEnemyState : uint8
+{
+	None,
+	Idle,
+	Patrol,
+	Chase,
+	Combat,
+};
+
+/**
+ * Per enemy constants used by transition logic (squared distances).
+ */
+struct FEnemyDecisionParams
+{
+	float AttackRangeSq = 0.0f;
+	float AttackRangeWithOffsetSq = 0.0f;
+	float ChaseStopDistanceSq = 0.0f;
+};
+
+/**
+ * Transition requested by evaluation, applied on game thread.
+ */
+struct FEnemyDecision
+{
+	EEnemyState NewState = EEnemyState::None;
+	bool bClearTarget = false;
+};
+
+/**
+ * Data oriented enemy AI decision state.
+ *
+ * State machine fields of all enemies live in contiguous arrays indexed by slot. Inputs that need
+ * actors (locations, target validity, movement status) are gathered on game thread, transitions are
+ * evaluated in parallel touching only the slot's own data, resulting decisions are applied by the
+ * controllers on game thread.
+ */
+class DODGER_API FEnemyDecisionCore
+{
+public:
+	enum EInputFlags : uint8
+	{
+		Input_TargetValid = 1 << 0,
+		Input_MoveIdle = 1 << 1,
+	};
+
+	int32 AllocateSlot(const FEnemyDecisionParams& InParams);
+	void ReleaseSlot(int32 Slot);
+	bool IsValidSlot(int32 Slot) const { return SlotUsed.IsValidIndex(Slot) && SlotUsed[Slot]; }
+
+	/**
+	 * Set per frame inputs of slot (game thread)
+	 */
+	void SetInputs(int32 Slot, float DeltaTime, const FVector& PawnLocation, const FVector& TargetLocation, uint8 Flags);
+	/**
+	 * Evaluate transitions of given slots in parallel, results are in Decisions
+	 */
+	void Evaluate(TConstArrayView<int32> Slots);
+
+	SIZE_T GetAllocatedSize() const;
+
+	// State - persistent per slot
+	TArray<EEnemyState> States;
+	TArray<float> StateTimeElapsed;
+	TArray<float> TimeToExitIdle;
+	TArray<float> ForcedChaseTimer;
+	TArray<TWeakObjectPtr<AActor>> Targets;
+	TArray<FEnemyDecisionParams> Params;
+
+	// Inputs - written on game thread before evaluation
+	TArray<float> DeltaTimes;
+	TArray<FVector> PawnLocations;
+	TArray<FVector> TargetLocations;
+	TArray<uint8> InputFlags;
+
+	// Outputs
+	TArray<FEnemyDecision> Decisions;
+
+private:
+	static void EvaluateSlot(int32 Slot, FEnemyDecisionCore& Core);
+
+	TBitArray<> SlotUsed;
+	TArray<int32> FreeSlots;
+};
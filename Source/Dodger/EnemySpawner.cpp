@@ -0,0 +1,277 @@
+
+#include "EnemySpawner.h"
+
+#include "DodgerCharacter.h"
+#include "DodgerStats.h"
+#include "DodgerStressTimings.h"
+#include "EngineUtils.h"
+#include "EnemyAIController.h"
+#include "NavigationSystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Data/EnemySpawnTable.h"
+#include "GameFramework/PlayerStart.h"
+
+DEFINE_LOG_CATEGORY_STATIC(EnemySpawnerLog, Log, All);
+
+namespace
+{
+	// Where pooled enemies wait, out of the playable space
+	const FVector PoolLocation(0.0, 0.0, -100000.0);
+}
+
+UEnemySpawner* UEnemySpawner::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UEnemySpawner>();
+	}
+
+	return nullptr;
+}
+
+bool UEnemySpawner::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemySpawner::StartWaves(const UEnemySpawnTable* InSpawnTable)
+{
+	LLM_SCOPE_BYTAG(Dodger_AI);
+	
+	if (!InSpawnTable || InSpawnTable->Waves.IsEmpty() || GetWorld()->IsNetMode(NM_Client))
+	{
+		return;
+	}
+
+	SpawnTable = InSpawnTable;
+	WaveIndex = 0;
+	NumSpawnedInWave = 0;
+	NextSpawnTime = GetWorld()->GetTimeSeconds() + SpawnTable->Waves[0].StartDelay;
+
+	// Create actors up front - spawning mid game only reuses them
+	TSet<TSubclassOf<ADodgerCharacter>> EnemyClasses;
+	for (const FEnemyWave& Wave : SpawnTable->Waves)
+	{
+		EnemyClasses.Add(Wave.EnemyClass);
+	}
+	for (const TSubclassOf<ADodgerCharacter>& EnemyClass : EnemyClasses)
+	{
+		Prewarm(EnemyClass, SpawnTable->PrewarmCount);
+	}
+}
+
+void UEnemySpawner::StopWaves()
+{
+	SpawnTable = nullptr;
+}
+
+void UEnemySpawner::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DODGER_STRESS_TIMING_SCOPE("EnemySpawner");
+	LLM_SCOPE_BYTAG(Dodger_AI);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Return dead enemies to the pool once their corpse time is up
+	for (int32 Index = ActiveEnemies.Num() - 1; Index >= 0; --Index)
+	{
+		const FPooledEnemy& Enemy = ActiveEnemies[Index];
+		if (!Enemy.Character || !Enemy.Controller)
+		{
+			ActiveEnemies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+		else if (Enemy.ReleaseTime > 0.0 && Now >= Enemy.ReleaseTime)
+		{
+			ReleaseEnemy(Enemy);
+			InactiveEnemies.Add(Enemy);
+			ActiveEnemies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+			// Spawned again by the wave below
+			if (SpawnTable && SpawnTable->bRespawnReleased && NumSpawnedInWave > 0)
+			{
+				--NumSpawnedInWave;
+			}
+		}
+	}
+
+	if (!SpawnTable)
+	{
+		return;
+	}
+
+	const FEnemyWave& Wave = SpawnTable->Waves[WaveIndex];
+	if (NumSpawnedInWave < Wave.Count)
+	{
+		// Zero interval spawns the whole wave at once
+		while (NumSpawnedInWave < Wave.Count && Now >= NextSpawnTime)
+		{
+			// No spawn location or enemy - the wave is not shortened, retried next tick
+			if (!SpawnEnemy(Wave.EnemyClass))
+			{
+				break;
+			}
+			++NumSpawnedInWave;
+			NextSpawnTime = Now + Wave.SpawnInterval;
+		}
+		return;
+	}
+
+	// Wave fully spawned - next one starts once all enemies are dead
+	const bool bWaveCleared = !ActiveEnemies.ContainsByPredicate([](const FPooledEnemy& Enemy) { return Enemy.ReleaseTime <= 0.0; });
+	if (bWaveCleared)
+	{
+		if (++WaveIndex >= SpawnTable->Waves.Num())
+		{
+			if (!SpawnTable->bLoopWaves)
+			{
+				StopWaves();
+				return;
+			}
+			WaveIndex = 0;
+		}
+
+		NumSpawnedInWave = 0;
+		NextSpawnTime = Now + SpawnTable->Waves[WaveIndex].StartDelay;
+	}
+}
+
+void UEnemySpawner::Prewarm(TSubclassOf<ADodgerCharacter> EnemyClass, int32 Count)
+{
+	const int32 NumPooled = InactiveEnemies.FilterByPredicate([EnemyClass](const FPooledEnemy& Enemy) { return Enemy.Character && Enemy.Character->GetClass() == EnemyClass; }).Num();
+	for (int32 Index = NumPooled; Index < Count; ++Index)
+	{
+		FPooledEnemy Enemy;
+		if (!CreatePooledEnemy(EnemyClass, Enemy))
+		{
+			return;
+		}
+		ReleaseEnemy(Enemy);
+		InactiveEnemies.Add(Enemy);
+	}
+}
+
+bool UEnemySpawner::CreatePooledEnemy(TSubclassOf<ADodgerCharacter> EnemyClass, FPooledEnemy& OutEnemy)
+{
+	if (!EnemyClass)
+	{
+		UE_LOG(EnemySpawnerLog, Error, TEXT("[%hs] Spawn table %s has a wave without enemy class."), __func__, *GetNameSafe(SpawnTable));
+		return false;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ADodgerCharacter* Character = GetWorld()->SpawnActor<ADodgerCharacter>(EnemyClass, PoolLocation, FRotator::ZeroRotator, SpawnParams);
+	if (!Character)
+	{
+		return false;
+	}
+
+	if (!Character->GetController())
+	{
+		Character->SpawnDefaultController();
+	}
+
+	AEnemyAIController* Controller = Cast<AEnemyAIController>(Character->GetController());
+	if (!Controller)
+	{
+		UE_LOG(EnemySpawnerLog, Error, TEXT("[%hs] %s is not controlled by an AEnemyAIController."), __func__, *GetNameSafe(EnemyClass));
+		if (Character->GetController())
+		{
+			Character->GetController()->Destroy();
+		}
+		Character->Destroy();
+		return false;
+	}
+
+	Character->OnDeath.AddUObject(this, &ThisClass::OnEnemyDeath);
+
+	OutEnemy.Character = Character;
+	OutEnemy.Controller = Controller;
+	OutEnemy.ReleaseTime = 0.0;
+	return true;
+}
+
+bool UEnemySpawner::SpawnEnemy(TSubclassOf<ADodgerCharacter> EnemyClass)
+{
+	FPooledEnemy Enemy;
+	const int32 PoolIndex = InactiveEnemies.IndexOfByPredicate([EnemyClass](const FPooledEnemy& Entry) { return Entry.Character && Entry.Character->GetClass() == EnemyClass; });
+	if (PoolIndex != INDEX_NONE)
+	{
+		Enemy = InactiveEnemies[PoolIndex];
+		InactiveEnemies.RemoveAtSwap(PoolIndex, 1, EAllowShrinking::No);
+	}
+	else
+	{
+		// Pool too small for the wave - grows, but this is the hitch pooling is meant to avoid
+		UE_LOG(EnemySpawnerLog, Verbose, TEXT("[%hs] Pool of %s empty, creating new enemy."), __func__, *GetNameSafe(EnemyClass));
+		if (!CreatePooledEnemy(EnemyClass, Enemy))
+		{
+			return false;
+		}
+		Enemy.Controller->UnPossess();
+	}
+
+	FVector Location;
+	if (!FindSpawnLocation(Location))
+	{
+		UE_LOG(EnemySpawnerLog, Warning, TEXT("[%hs] No spawn location found."), __func__);
+		InactiveEnemies.Add(Enemy);
+		return false;
+	}
+	Location.Z += Enemy.Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+	const FRotator Rotation(0.0, FMath::FRandRange(-180.0, 180.0), 0.0);
+	Enemy.Character->ActivateFromPool(Location, Rotation);
+	Enemy.Controller->Possess(Enemy.Character);
+	Enemy.ReleaseTime = 0.0;
+	ActiveEnemies.Add(Enemy);
+
+	return true;
+}
+
+bool UEnemySpawner::FindSpawnLocation(FVector& OutLocation) const
+{
+	TArray<const APlayerStart*, TInlineAllocator<8>> PlayerStarts;
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		PlayerStarts.Add(*It);
+	}
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (PlayerStarts.IsEmpty() || !NavSys)
+	{
+		return false;
+	}
+
+	const FVector Origin = PlayerStarts[FMath::RandHelper(PlayerStarts.Num())]->GetActorLocation();
+	FNavLocation Result;
+	if (NavSys->GetRandomReachablePointInRadius(Origin, SpawnTable->SpawnRadius, Result))
+	{
+		OutLocation = Result.Location;
+		return true;
+	}
+
+	return false;
+}
+
+void UEnemySpawner::ReleaseEnemy(const FPooledEnemy& Enemy)
+{
+	Enemy.Controller->UnPossess();
+	Enemy.Character->DeactivateForPool(PoolLocation);
+}
+
+void UEnemySpawner::OnEnemyDeath(ADodgerCharacter* Character)
+{
+	if (FPooledEnemy* Enemy = ActiveEnemies.FindByPredicate([Character](const FPooledEnemy& Entry) { return Entry.Character == Character; }))
+	{
+		const float CorpseLifetime = SpawnTable ? SpawnTable->CorpseLifetime : 0.0f;
+		Enemy->ReleaseTime = GetWorld()->GetTimeSeconds() + FMath::Max(CorpseLifetime, UE_KINDA_SMALL_NUMBER);
+	}
+}
+
+TStatId UEnemySpawner::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySpawner, STATGROUP_Tickables);
+}
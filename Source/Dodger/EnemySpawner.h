@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySpawner.generated.h"
+
+class ADodgerCharacter;
+class AEnemyAIController;
+class UEnemySpawnTable;
+
+USTRUCT()
+struct FPooledEnemy
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<ADodgerCharacter> Character = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<AEnemyAIController> Controller = nullptr;
+
+	// Server time when dead enemy returns to pool
+	double ReleaseTime = 0.0;
+};
+
+/**
+ * Spawns enemy waves from a spawn table (server only).
+ * Character/controller pairs are pooled - dead enemies return to the pool after a while and are
+ * reset (health, combat, rewind history, AI) when reused, so long sessions don't keep creating actors.
+ */
+UCLASS()
+class DODGER_API UEnemySpawner : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEnemySpawner* Get(const UObject* WorldContext);
+	/**
+	 *  Prewarm pool and start spawning waves of given table
+	 */
+	void StartWaves(const UEnemySpawnTable* InSpawnTable);
+	void StopWaves();
+	
+	// Base Interface Start
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	
+private:
+	void Prewarm(TSubclassOf<ADodgerCharacter> EnemyClass, int32 Count);
+	bool CreatePooledEnemy(TSubclassOf<ADodgerCharacter> EnemyClass, FPooledEnemy& OutEnemy);
+	bool SpawnEnemy(TSubclassOf<ADodgerCharacter> EnemyClass);
+	bool FindSpawnLocation(FVector& OutLocation) const;
+	void ReleaseEnemy(const FPooledEnemy& Enemy);
+	void OnEnemyDeath(ADodgerCharacter* Character);
+	
+	UPROPERTY(Transient)
+	TObjectPtr<const UEnemySpawnTable> SpawnTable;
+	
+	UPROPERTY(Transient)
+	TArray<FPooledEnemy> ActiveEnemies;
+
+	UPROPERTY(Transient)
+	TArray<FPooledEnemy> InactiveEnemies;
+
+	int32 WaveIndex = 0;
+	int32 NumSpawnedInWave = 0;
+	double NextSpawnTime = 0.0;
+};
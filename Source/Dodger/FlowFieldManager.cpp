@@ -0,0 +1,366 @@
+
+#include "FlowFieldManager.h"
+
+#include "AIController.h"
+#include "DodgerStats.h"
+#include "DodgerStressTimings.h"
+#include "NavigationSystem.h"
+#include "Data/EnemyConfig.h"
+#include "GameFramework/Pawn.h"
+#include "Navigation/PathFollowingComponent.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarFlowFieldCellsPerFrame(
+		TEXT("Dodger.AI.FlowFieldCellsPerFrame"),
+		1024,
+		TEXT("Number of grid cells expanded per frame when rebuilding chase flow fields."));
+
+	constexpr uint16 UnreachedDistance = MAX_uint16;
+
+	// Vertical tolerance of navmesh projection for walkability, also height of cached walkability bands
+	constexpr float WalkableProjectionHeight = 200.0f;
+
+	// Walkability cache is dropped when it grows over this many entries
+	constexpr int32 MaxCachedWalkableCells = 64 * 1024;
+
+	const FIntPoint NeighbourOffsets[] = {
+		{1, 0}, {-1, 0}, {0, 1}, {0, -1},
+		{1, 1}, {1, -1}, {-1, 1}, {-1, -1},
+	};
+}
+
+UFlowFieldManager* UFlowFieldManager::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UFlowFieldManager>();
+	}
+
+	return nullptr;
+}
+
+bool UFlowFieldManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UFlowFieldManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UEnemyConfig* Config = GetDefault<UEnemyConfig>();
+	CellSize = FMath::Max(Config->FlowFieldCellSize, 1.0f);
+	GridSize = 2 * FMath::CeilToInt32(Config->FlowFieldExtent / CellSize) + 1;
+}
+
+void UFlowFieldManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Cached walkability is stale once navmesh changes (dynamic obstacles, streamed levels)
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &ThisClass::OnNavigationGenerationFinished);
+	}
+}
+
+void UFlowFieldManager::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	WalkableCells.Reset();
+}
+
+void UFlowFieldManager::StartFollowing(AAIController* Follower, AActor* Target)
+{
+	if (!Follower || !Target)
+	{
+		return;
+	}
+
+	FFollower* Existing = Followers.FindByPredicate([Follower](const FFollower& Entry) { return Entry.Controller == Follower; });
+	FFollower& Entry = Existing ? *Existing : Followers.AddDefaulted_GetRef();
+	Entry.Controller = Follower;
+	Entry.Target = Target;
+
+	FindOrAddField(Target);
+
+	Follower->SetFocus(Target, EAIFocusPriority::Move);
+}
+
+void UFlowFieldManager::StopFollowing(AAIController* Follower)
+{
+	const int32 Index = Followers.IndexOfByPredicate([Follower](const FFollower& Entry) { return Entry.Controller == Follower; });
+	if (Index != INDEX_NONE)
+	{
+		Followers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Follower->ClearFocus(EAIFocusPriority::Move);
+	}
+}
+
+void UFlowFieldManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DODGER_STRESS_TIMING_SCOPE("FlowFields");
+	LLM_SCOPE_BYTAG(Dodger_AI);
+
+	Followers.RemoveAllSwap([](const FFollower& Entry) { return !Entry.Controller.IsValid() || !Entry.Target.IsValid(); }, EAllowShrinking::No);
+
+	// Fields nobody follows anymore
+	Fields.RemoveAllSwap([this](const FFlowField& Field)
+	{
+		return !Field.Target.IsValid() || !Followers.ContainsByPredicate([&Field](const FFollower& Entry) { return Entry.Target == Field.Target; });
+	}, EAllowShrinking::No);
+
+	if (Fields.IsEmpty())
+	{
+		return;
+	}
+
+	// Restart builds for targets that moved to another cell, the previous field stays usable meanwhile
+	for (FFlowField& Field : Fields)
+	{
+		const FIntPoint TargetCell = GetCell(Field.Target->GetActorLocation());
+		if (!Field.bBuilding && (!Field.bValid || TargetCell != Field.TargetCell))
+		{
+			Field.BuildHeight = Field.Target->GetActorLocation().Z;
+			StartBuild(Field, TargetCell);
+		}
+	}
+
+	// Spread cell budget across building fields
+	int32 CellBudget = CVarFlowFieldCellsPerFrame.GetValueOnGameThread();
+	for (int32 Visited = 0; Visited < Fields.Num() && CellBudget > 0; ++Visited)
+	{
+		BuildCursor = (BuildCursor + 1) % Fields.Num();
+		FFlowField& Field = Fields[BuildCursor];
+		if (Field.bBuilding)
+		{
+			CellBudget -= ContinueBuild(Field, CellBudget);
+		}
+	}
+
+	for (const FFollower& Follower : Followers)
+	{
+		UpdateFollower(Follower);
+	}
+}
+
+UFlowFieldManager::FFlowField& UFlowFieldManager::FindOrAddField(AActor* Target)
+{
+	if (FFlowField* Field = Fields.FindByPredicate([Target](const FFlowField& Entry) { return Entry.Target == Target; }))
+	{
+		return *Field;
+	}
+
+	FFlowField& Field = Fields.AddDefaulted_GetRef();
+	Field.Target = Target;
+	return Field;
+}
+
+const UFlowFieldManager::FFlowField* UFlowFieldManager::FindField(const AActor* Target) const
+{
+	return Fields.FindByPredicate([Target](const FFlowField& Entry) { return Entry.Target == Target; });
+}
+
+void UFlowFieldManager::StartBuild(FFlowField& Field, const FIntPoint& TargetCell)
+{
+	const int32 HalfSize = GridSize / 2;
+	Field.BuildTargetCell = TargetCell;
+	Field.BuildOrigin = TargetCell - FIntPoint(HalfSize, HalfSize);
+	Field.BuildDistances.Init(UnreachedDistance, GridSize * GridSize);
+	Field.Frontier.Reset();
+	Field.FrontierHead = 0;
+	Field.bBuilding = true;
+
+	const int32 TargetIndex = HalfSize * GridSize + HalfSize;
+	Field.BuildDistances[TargetIndex] = 0;
+	Field.Frontier.Add(TargetIndex);
+}
+
+int32 UFlowFieldManager::ContinueBuild(FFlowField& Field, int32 CellBudget)
+{
+	int32 Expanded = 0;
+	while (Field.FrontierHead < Field.Frontier.Num() && Expanded < CellBudget)
+	{
+		const int32 Index = Field.Frontier[Field.FrontierHead++];
+		const FIntPoint Local(Index % GridSize, Index / GridSize);
+		const uint16 NextDistance = Field.BuildDistances[Index] + 1;
+		++Expanded;
+
+		for (const FIntPoint& Offset : NeighbourOffsets)
+		{
+			const FIntPoint Neighbour = Local + Offset;
+			if (Neighbour.X < 0 || Neighbour.Y < 0 || Neighbour.X >= GridSize || Neighbour.Y >= GridSize)
+			{
+				continue;
+			}
+
+			const int32 NeighbourIndex = Neighbour.Y * GridSize + Neighbour.X;
+			if (Field.BuildDistances[NeighbourIndex] != UnreachedDistance)
+			{
+				continue;
+			}
+
+			if (!IsWalkable(Field.BuildOrigin + Neighbour, Field.BuildHeight))
+			{
+				continue;
+			}
+
+			// Don't cut corners of blocked cells
+			if (Offset.X != 0 && Offset.Y != 0 &&
+				(!IsWalkable(Field.BuildOrigin + FIntPoint(Neighbour.X, Local.Y), Field.BuildHeight) ||
+				 !IsWalkable(Field.BuildOrigin + FIntPoint(Local.X, Neighbour.Y), Field.BuildHeight)))
+			{
+				continue;
+			}
+
+			Field.BuildDistances[NeighbourIndex] = NextDistance;
+			Field.Frontier.Add(NeighbourIndex);
+		}
+	}
+
+	// Flood fill done - swap in the new field
+	if (Field.FrontierHead >= Field.Frontier.Num())
+	{
+		Swap(Field.Distances, Field.BuildDistances);
+		Field.Origin = Field.BuildOrigin;
+		Field.TargetCell = Field.BuildTargetCell;
+		Field.bValid = true;
+		Field.bBuilding = false;
+	}
+
+	return Expanded;
+}
+
+bool UFlowFieldManager::SampleDirection(const AActor* Target, const FVector& Location, FVector& OutDirection) const
+{
+	const FFlowField* Field = FindField(Target);
+	if (!Field || !Field->bValid)
+	{
+		return false;
+	}
+
+	const FIntPoint Local = GetCell(Location) - Field->Origin;
+	if (Local.X < 0 || Local.Y < 0 || Local.X >= GridSize || Local.Y >= GridSize)
+	{
+		return false;
+	}
+
+	const uint16 Distance = Field->Distances[Local.Y * GridSize + Local.X];
+	if (Distance == UnreachedDistance)
+	{
+		return false;
+	}
+
+	// In target cell - head straight to it
+	if (Distance == 0)
+	{
+		OutDirection = (Target->GetActorLocation() - Location).GetSafeNormal2D();
+		return true;
+	}
+
+	FIntPoint BestNeighbour = Local;
+	uint16 BestDistance = Distance;
+	for (const FIntPoint& Offset : NeighbourOffsets)
+	{
+		const FIntPoint Neighbour = Local + Offset;
+		if (Neighbour.X < 0 || Neighbour.Y < 0 || Neighbour.X >= GridSize || Neighbour.Y >= GridSize)
+		{
+			continue;
+		}
+
+		const uint16 NeighbourDistance = Field->Distances[Neighbour.Y * GridSize + Neighbour.X];
+		if (NeighbourDistance < BestDistance)
+		{
+			BestDistance = NeighbourDistance;
+			BestNeighbour = Neighbour;
+		}
+	}
+
+	if (BestNeighbour == Local)
+	{
+		return false;
+	}
+
+	OutDirection = (GetCellCenter(Field->Origin + BestNeighbour, Location.Z) - Location).GetSafeNormal2D();
+	return true;
+}
+
+void UFlowFieldManager::UpdateFollower(const FFollower& Follower) const
+{
+	AAIController* Controller = Follower.Controller.Get();
+	APawn* Pawn = Controller->GetPawn();
+	if (!Pawn)
+	{
+		return;
+	}
+
+	FVector Direction;
+	if (SampleDirection(Follower.Target.Get(), Pawn->GetActorLocation(), Direction))
+	{
+		// Back in the field - drop fallback path
+		if (Controller->GetMoveStatus() != EPathFollowingStatus::Idle)
+		{
+			Controller->StopMovement();
+		}
+		Pawn->AddMovementInput(Direction);
+	}
+	else if (Controller->GetMoveStatus() == EPathFollowingStatus::Idle)
+	{
+		// Outside of the field (or field not built yet) - regular path following
+		Controller->MoveToActor(Follower.Target.Get());
+	}
+}
+
+bool UFlowFieldManager::IsWalkable(const FIntPoint& Cell, double Height)
+{
+	// Projected from the middle of the height band, so each level of multi-level geometry gets its own entry
+	const int32 Band = FMath::FloorToInt32(Height / WalkableProjectionHeight);
+	const FIntVector Key(Cell.X, Cell.Y, Band);
+	if (const bool* bCachedWalkable = WalkableCells.Find(Key))
+	{
+		return *bCachedWalkable;
+	}
+
+	bool bWalkable = false;
+	if (const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		FNavLocation Projected;
+		const FVector Extent(CellSize * 0.5f, CellSize * 0.5f, WalkableProjectionHeight);
+		bWalkable = NavSys->ProjectPointToNavigation(GetCellCenter(Cell, (Band + 0.5) * WalkableProjectionHeight), Projected, Extent);
+	}
+
+	if (WalkableCells.Num() >= MaxCachedWalkableCells)
+	{
+		WalkableCells.Reset();
+	}
+
+	WalkableCells.Add(Key, bWalkable);
+	return bWalkable;
+}
+
+FIntPoint UFlowFieldManager::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+FVector UFlowFieldManager::GetCellCenter(const FIntPoint& Cell, double Height) const
+{
+	return FVector((Cell.X + 0.5) * CellSize, (Cell.Y + 0.5) * CellSize, Height);
+}
+
+SIZE_T UFlowFieldManager::GetAllocatedSize() const
+{
+	SIZE_T Size = Fields.GetAllocatedSize() + Followers.GetAllocatedSize() + WalkableCells.GetAllocatedSize();
+	for (const FFlowField& Field : Fields)
+	{
+		Size += Field.Distances.GetAllocatedSize() + Field.BuildDistances.GetAllocatedSize() + Field.Frontier.GetAllocatedSize();
+	}
+	return Size;
+}
+
+TStatId UFlowFieldManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlowFieldManager, STATGROUP_Tickables);
+}
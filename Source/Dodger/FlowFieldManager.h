@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FlowFieldManager.generated.h"
+
+class AAIController;
+class ANavigationData;
+
+/**
+ * Shared chase navigation (server only).
+ * Keeps one distance field per chased target on a 2D grid around it, rebuilt incrementally (time-sliced)
+ * whenever the target moves to another cell. Followers steer by sampling the field every frame instead
+ * of running their own path queries, so pathing cost scales with targets, not chasers.
+ * Followers fall back to regular path following when they are outside of the field.
+ */
+UCLASS()
+class DODGER_API UFlowFieldManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UFlowFieldManager* Get(const UObject* WorldContext);
+	/**
+	 *  Start/stop steering follower towards target, focus is set on the target while following
+	 */
+	void StartFollowing(AAIController* Follower, AActor* Target);
+	void StopFollowing(AAIController* Follower);
+	/**
+	 *  Direction towards target of given field at location, false if location is not covered by the field
+	 */
+	bool SampleDirection(const AActor* Target, const FVector& Location, FVector& OutDirection) const;
+	/**
+	 *  Memory owned by fields, followers and walkability cache (see UDodgerMemoryTracker)
+	 */
+	SIZE_T GetAllocatedSize() const;
+	
+	// Base Interface Start
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	
+private:
+	struct FFlowField
+	{
+		TWeakObjectPtr<AActor> Target;
+
+		// Completed field - distance in cells to target per grid cell
+		FIntPoint Origin = FIntPoint::ZeroValue;
+		FIntPoint TargetCell = FIntPoint::ZeroValue;
+		TArray<uint16> Distances;
+		bool bValid = false;
+
+		// Field being built - swapped in once the flood fill is done
+		FIntPoint BuildOrigin = FIntPoint::ZeroValue;
+		FIntPoint BuildTargetCell = FIntPoint::ZeroValue;
+		double BuildHeight = 0.0;
+		TArray<uint16> BuildDistances;
+		TArray<int32> Frontier;
+		int32 FrontierHead = 0;
+		bool bBuilding = false;
+	};
+
+	struct FFollower
+	{
+		TWeakObjectPtr<AAIController> Controller;
+		TWeakObjectPtr<AActor> Target;
+	};
+
+	FFlowField& FindOrAddField(AActor* Target);
+	const FFlowField* FindField(const AActor* Target) const;
+	void StartBuild(FFlowField& Field, const FIntPoint& TargetCell);
+	int32 ContinueBuild(FFlowField& Field, int32 CellBudget);
+	void UpdateFollower(const FFollower& Follower) const;
+	
+	bool IsWalkable(const FIntPoint& Cell, double Height);
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+	FIntPoint GetCell(const FVector& Location) const;
+	FVector GetCellCenter(const FIntPoint& Cell, double Height) const;
+	
+	TArray<FFlowField> Fields;
+	TArray<FFollower> Followers;
+	
+	// Navmesh projection results per world cell and height band (Z), dropped when navmesh is rebuilt
+	TMap<FIntVector, bool> WalkableCells;
+
+	float CellSize = 100.0f;
+	int32 GridSize = 1;
+
+	// Round robin position of field builds
+	int32 BuildCursor = 0;
+};
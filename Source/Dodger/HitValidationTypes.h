@@ -25,6 +25,13 @@ struct FCharacterFrameData
 	bool bIsInvulnerable = false;
 };
 
+struct FInvulnerabilityWindow
+{
+	float StartTime = 0.0f;
+
+	float EndTime = 0.0f;
+};
+
 struct FHitVerificationResult
 {
 	bool bIsValidHit : 1;
@@ -0,0 +1,149 @@
+
+#include "HitboxPoseCache.h"
+
+#include "Algo/Compare.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "DodgerStats.h"
+
+DEFINE_LOG_CATEGORY_STATIC(HitboxPoseLog, Log, All);
+
+namespace
+{
+	// Bake rate - fast enough for dodge/attack motion, interpolated in between
+	constexpr float BakeSampleRate = 30.0f;
+
+	// Local transform of bone at montage position, reference pose where montage has no animation
+	FTransform GetLocalTransform(const UAnimMontage* Montage, const FReferenceSkeleton& RefSkeleton, int32 BoneIndex, float Position)
+	{
+		// Root motion moves the capsule, keep root where the mesh expects it
+		if (BoneIndex > 0 && Montage->SlotAnimTracks.Num() > 0)
+		{
+			if (const FAnimSegment* Segment = Montage->SlotAnimTracks[0].AnimTrack.GetSegmentAtTime(Position))
+			{
+				if (const UAnimSequence* Sequence = Cast<UAnimSequence>(Segment->GetAnimReference()))
+				{
+					FTransform LocalTransform;
+					const FAnimExtractContext ExtractContext(static_cast<double>(Segment->ConvertTrackPosToAnimPos(Position)));
+					Sequence->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(BoneIndex), ExtractContext, false);
+					return LocalTransform;
+				}
+			}
+		}
+
+		return RefSkeleton.GetRefBonePose()[BoneIndex];
+	}
+}
+
+FTransform FHitboxBoneTracks::Sample(int32 BoneIndex, float Position) const
+{
+	if (NumSamples == 0)
+	{
+		return FTransform::Identity;
+	}
+
+	const float SamplePosition = FMath::Clamp(Position * SampleRate, 0.0f, static_cast<float>(NumSamples - 1));
+	const int32 Sample0 = FMath::FloorToInt32(SamplePosition);
+	const int32 Sample1 = FMath::Min(Sample0 + 1, NumSamples - 1);
+	const float Alpha = SamplePosition - Sample0;
+
+	const FTransform& Transform0 = Transforms[Sample0 * Bones.Num() + BoneIndex];
+	const FTransform& Transform1 = Transforms[Sample1 * Bones.Num() + BoneIndex];
+
+	FTransform Result;
+	Result.Blend(Transform0, Transform1, Alpha);
+	return Result;
+}
+
+UHitboxPoseCache* UHitboxPoseCache::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UHitboxPoseCache>();
+	}
+
+	return nullptr;
+}
+
+bool UHitboxPoseCache::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+const FHitboxBoneTracks* UHitboxPoseCache::FindOrBake(const UAnimMontage* Montage, const USkeleton* Skeleton, TConstArrayView<FName> Bones)
+{
+	LLM_SCOPE_BYTAG(Dodger_HitValidation);
+	
+	if (!Montage || !Skeleton)
+	{
+		return nullptr;
+	}
+
+	uint32 BonesHash = 0;
+	for (const FName& Bone : Bones)
+	{
+		BonesHash = HashCombineFast(BonesHash, GetTypeHash(Bone));
+	}
+
+	FHitboxBoneTracks& Tracks = BakedMontages.FindOrAdd(FBakeKey(Montage, Skeleton, BonesHash));
+	if (Tracks.NumSamples == 0 || !Algo::Compare(Tracks.Bones, Bones))
+	{
+		// Once per montage and bone set for all characters, rebaked only on hash collision
+		Bake(Montage, Skeleton, Bones, Tracks);
+	}
+
+	return Tracks.NumSamples > 0 ? &Tracks : nullptr;
+}
+
+void UHitboxPoseCache::Bake(const UAnimMontage* Montage, const USkeleton* Skeleton, TConstArrayView<FName> Bones, FHitboxBoneTracks& OutTracks)
+{
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+
+	// Bone chains up to root - the only bones that are evaluated
+	TArray<TArray<int32>> Chains;
+	for (const FName& Bone : Bones)
+	{
+		TArray<int32>& Chain = Chains.AddDefaulted_GetRef();
+		for (int32 BoneIndex = RefSkeleton.FindBoneIndex(Bone); BoneIndex != INDEX_NONE; BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+		{
+			Chain.Add(BoneIndex);
+		}
+
+		if (Chain.IsEmpty())
+		{
+			UE_LOG(HitboxPoseLog, Warning, TEXT("[%hs] Bone %s not found in skeleton %s."), __func__, *Bone.ToString(), *GetNameSafe(Skeleton));
+		}
+	}
+
+	OutTracks.Bones = TArray<FName>(Bones);
+	OutTracks.SampleRate = BakeSampleRate;
+	OutTracks.NumSamples = FMath::FloorToInt32(Montage->GetPlayLength() * BakeSampleRate) + 1;
+	OutTracks.Transforms.SetNumUninitialized(OutTracks.NumSamples * Bones.Num());
+
+	for (int32 SampleIndex = 0; SampleIndex < OutTracks.NumSamples; ++SampleIndex)
+	{
+		const float Position = FMath::Min(SampleIndex / BakeSampleRate, Montage->GetPlayLength());
+		for (int32 BoneIndex = 0; BoneIndex < Chains.Num(); ++BoneIndex)
+		{
+			// Chain goes from the bone up, accumulate child-to-parent
+			FTransform Transform = FTransform::Identity;
+			for (const int32 ChainBoneIndex : Chains[BoneIndex])
+			{
+				Transform *= GetLocalTransform(Montage, RefSkeleton, ChainBoneIndex, Position);
+			}
+
+			OutTracks.Transforms[SampleIndex * Bones.Num() + BoneIndex] = Transform;
+		}
+	}
+}
+
+SIZE_T UHitboxPoseCache::GetAllocatedSize() const
+{
+	SIZE_T Size = BakedMontages.GetAllocatedSize();
+	for (const TPair<FBakeKey, FHitboxBoneTracks>& Pair : BakedMontages)
+	{
+		Size += Pair.Value.Bones.GetAllocatedSize() + Pair.Value.Transforms.GetAllocatedSize();
+	}
+	return Size;
+}
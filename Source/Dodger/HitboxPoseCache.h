@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "HitboxPoseCache.generated.h"
+
+class UAnimMontage;
+class USkeleton;
+
+/**
+ * Component space transforms of a few bones sampled over a montage.
+ */
+struct FHitboxBoneTracks
+{
+	TArray<FName> Bones;
+	float SampleRate = 30.0f;
+	int32 NumSamples = 0;
+
+	// Sample major - [SampleIndex * Bones.Num() + BoneIndex]
+	TArray<FTransform> Transforms;
+
+	/**
+	 * Component space transform of bone (index into Bones) at montage position
+	 */
+	FTransform Sample(int32 BoneIndex, float Position) const;
+};
+
+/**
+ * Bakes bone tracks of montages for server hitboxes, so dedicated servers don't need to evaluate
+ * full skeletal poses while montages play (server only). Only the bone chains of requested bones are evaluated,
+ * root bone is kept at reference pose as root motion moves the capsule instead.
+ */
+UCLASS()
+class DODGER_API UHitboxPoseCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UHitboxPoseCache* Get(const UObject* WorldContext);
+	/**
+	 *  Baked tracks of bones for montage, baked on first request
+	 */
+	const FHitboxBoneTracks* FindOrBake(const UAnimMontage* Montage, const USkeleton* Skeleton, TConstArrayView<FName> Bones);
+	/**
+	 *  Memory owned by baked tracks (see UDodgerMemoryTracker)
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	static void Bake(const UAnimMontage* Montage, const USkeleton* Skeleton, TConstArrayView<FName> Bones, FHitboxBoneTracks& OutTracks);
+	
+	// Montage, skeleton and hash of the bone list - characters with different hitboxes share montages
+	using FBakeKey = TTuple<TObjectKey<UAnimMontage>, TObjectKey<USkeleton>, uint32>;
+	TMap<FBakeKey, FHitboxBoneTracks> BakedMontages;
+};
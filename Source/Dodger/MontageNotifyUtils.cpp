@@ -0,0 +1,44 @@
+
+#include "MontageNotifyUtils.h"
+
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimNotifies/AnimNotify.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+
+namespace
+{
+	FName GetMontageNotifyName(const FAnimNotifyEvent& Event)
+	{
+		const UObject* NotifyObject = Event.NotifyStateClass ? static_cast<const UObject*>(Event.NotifyStateClass) : static_cast<const UObject*>(Event.Notify);
+		if (NotifyObject)
+		{
+			// Montage notifies keep the broadcast name in their (protected) NotifyName property
+			if (const FNameProperty* NameProperty = FindFProperty<FNameProperty>(NotifyObject->GetClass(), TEXT("NotifyName")))
+			{
+				return NameProperty->GetPropertyValue_InContainer(NotifyObject);
+			}
+		}
+
+		return Event.NotifyName;
+	}
+}
+
+bool MontageNotifyUtils::FindNotify(const UAnimMontage* Montage, FName NotifyName, float& OutStartTime, float& OutEndTime)
+{
+	if (!Montage)
+	{
+		return false;
+	}
+
+	for (const FAnimNotifyEvent& Event : Montage->Notifies)
+	{
+		if (GetMontageNotifyName(Event) == NotifyName)
+		{
+			OutStartTime = Event.GetTriggerTime();
+			OutEndTime = Event.NotifyStateClass ? Event.GetEndTriggerTime() : OutStartTime;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAnimMontage;
+
+namespace MontageNotifyUtils
+{
+	/**
+	 * Find montage notify (or notify window) by the name it reports to OnPlayMontageNotifyBegin.
+	 * Times are montage positions, divide by play rate to get real time.
+	 * @return true if notify was found
+	 */
+	DODGER_API bool FindNotify(const UAnimMontage* Montage, FName NotifyName, float& OutStartTime, float& OutEndTime);
+}
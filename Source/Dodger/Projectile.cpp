@@ -3,8 +3,12 @@
 
 #include "Projectile.h"
 
+#include "DamageManager.h"
 #include "DodgerCharacter.h"
 #include "DodgerPlayerController.h"
+#include "DodgerStats.h"
+#include "DodgerStressTimings.h"
+#include "StimulusManager.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Components/BoxComponent.h"
 #include "Components/DodgerCombatComponent.h"
@@ -111,6 +115,8 @@ void AProjectile::BeginPlay()
 void AProjectile::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	DODGER_STRESS_TIMING_SCOPE("Projectiles");
 }
 
 void AProjectile::HandleCharacterHit(ADodgerCharacter* Attacker, ADodgerCharacter* HitCharacter, const FHitResult& ImpactResult)
@@ -130,11 +136,11 @@ void AProjectile::HandleCharacterHit(ADodgerCharacter* Attacker, ADodgerCharacte
 		}
 		else
 		{
-			// server side - do instant check
-			if (!HitCharacter->IsInvulnerable())
+			// server side - do instant check against the server invulnerability timeline
+			if (!HitCharacter->GetHitValidation()->IsInvulnerableAt(GetWorld()->GetTimeSeconds()))
 			{
-				float DamageMultiplier = (Cast<UBoxComponent>(ImpactResult.GetComponent()) == HitCharacter->GetHitBoxHead()) ? 2.0f : 1.0f;
-				UGameplayStatics::ApplyDamage(HitCharacter, Config->Damage * DamageMultiplier, Attacker->Controller, Attacker, UDamageType::StaticClass());
+				const bool bHeadshot = Cast<UBoxComponent>(ImpactResult.GetComponent()) == HitCharacter->GetHitBoxHead();
+				UDamageManager::Get(this)->QueueHit(HitCharacter, Config->GetHitDamage(bHeadshot), bHeadshot, Attacker->Controller, Attacker);
 			}
 		}
 	}
@@ -155,6 +161,9 @@ void AProjectile::PlayHitEffects()
 
 void AProjectile::OnProjectileHit(const FHitResult& ImpactResult)
 {
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerProjectileHit);
+	DODGER_INC_COUNTER(STAT_DodgerProjectileHits, 1);
+	
 	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, "Stop Movement");
 	
 	if (!GetInstigator())
@@ -173,7 +182,10 @@ void AProjectile::OnProjectileHit(const FHitResult& ImpactResult)
 
 	if (InstigatorCharacter && InstigatorCharacter->HasAuthority())
 	{
-		InstigatorCharacter->MakeNoise(1, InstigatorCharacter, GetActorLocation());
+		if (UStimulusManager* StimulusManager = UStimulusManager::Get(this))
+		{
+			StimulusManager->ReportNoise(GetActorLocation(), InstigatorCharacter);
+		}
 	}
 	
 	PlayHitEffects();
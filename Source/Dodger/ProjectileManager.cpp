@@ -2,6 +2,8 @@
 
 #include "ProjectileManager.h"
 
+#include "DodgerStats.h"
+
 UProjectileManager* UProjectileManager::Get(const UObject* WorldContext)
 {
 	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
@@ -14,6 +16,10 @@ UProjectileManager* UProjectileManager::Get(const UObject* WorldContext)
 
 AProjectile* UProjectileManager::LaunchProjectile(TSubclassOf<AProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, APawn* Instigator)
 {
+	DODGER_SCOPE_CYCLE_COUNTER(STAT_DodgerLaunchProjectile);
+	LLM_SCOPE_BYTAG(Dodger_Projectiles);
+	DODGER_INC_COUNTER(STAT_DodgerProjectilesLaunched, 1);
+	
 	for (int32 i = 0 ; i < ProjectilePool.Num(); ++i)
 	{
 		AProjectile* Projectile = ProjectilePool[i];
@@ -31,6 +37,7 @@ AProjectile* UProjectileManager::LaunchProjectile(TSubclassOf<AProjectile> Proje
 	}
 
 	// If no projectile is available, spawn a new one
+	DODGER_INC_COUNTER(STAT_DodgerProjectilesSpawned, 1);
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.Instigator = Instigator;
 	AProjectile* NewProjectile = GetWorld()->SpawnActor<AProjectile>(ProjectileClass, Location, Rotation, SpawnParams);
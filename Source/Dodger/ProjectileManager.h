@@ -24,6 +24,11 @@ public:
 	 *  Global delegate to detect any projectile hit
 	 */
 	FOnProjectileHitDelegate OnProjectileHitDelegate;
+	/**
+	 *  Memory owned by the manager and number of pooled projectiles (see UDodgerMemoryTracker)
+	 */
+	SIZE_T GetAllocatedSize() const { return ProjectilePool.GetAllocatedSize(); }
+	int32 GetNumPooled() const { return ProjectilePool.Num(); }
 	
 private:
 	/**
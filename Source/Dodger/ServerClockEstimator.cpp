@@ -0,0 +1,167 @@
+
+#include "ServerClockEstimator.h"
+
+namespace
+{
+	// Minimal amount of samples and time covered before fitting drift
+	constexpr int32 MinSamplesForDrift = 4;
+	constexpr double MinDriftTimeSpan = 5.0;
+
+	// Lower bound for jitter used in sample weighting, avoids dividing by zero on perfect links
+	constexpr double MinJitterForWeighting = 0.001;
+}
+
+FServerClockEstimator::FServerClockEstimator(const FSettings& InSettings)
+	: Settings(InSettings)
+{
+	Settings.MaxSamples = FMath::Max(Settings.MaxSamples, 1);
+}
+
+void FServerClockEstimator::AddSample(double ClientSendTime, double ServerTime, double ClientReceiveTime)
+{
+	const double RoundTripTime = ClientReceiveTime - ClientSendTime;
+
+	// Reply older than the request - corrupted or reordered data
+	if (RoundTripTime < 0.0)
+	{
+		return;
+	}
+
+	FClockSyncSample Sample;
+	Sample.RoundTripTime = RoundTripTime;
+	Sample.LocalTime = ClientReceiveTime;
+	// Server processed the request roughly half way through the round trip
+	Sample.Offset = ServerTime + 0.5 * RoundTripTime - ClientReceiveTime;
+
+	if (Samples.Num() < Settings.MaxSamples)
+	{
+		Samples.Add(Sample);
+	}
+	else
+	{
+		Samples[NextSampleIndex] = Sample;
+	}
+	NextSampleIndex = (NextSampleIndex + 1) % Settings.MaxSamples;
+
+	RefreshEstimate();
+}
+
+void FServerClockEstimator::RefreshEstimate()
+{
+	if (Samples.IsEmpty())
+	{
+		return;
+	}
+
+	// Round trip statistics
+	double LatestLocalTime = Samples[0].LocalTime;
+	double OldestLocalTime = Samples[0].LocalTime;
+	double MeanRoundTrip = 0.0;
+	MinRoundTripTime = Samples[0].RoundTripTime;
+	for (const FClockSyncSample& Sample : Samples)
+	{
+		MinRoundTripTime = FMath::Min(MinRoundTripTime, Sample.RoundTripTime);
+		LatestLocalTime = FMath::Max(LatestLocalTime, Sample.LocalTime);
+		OldestLocalTime = FMath::Min(OldestLocalTime, Sample.LocalTime);
+		MeanRoundTrip += Sample.RoundTripTime;
+	}
+	MeanRoundTrip /= Samples.Num();
+
+	double Variance = 0.0;
+	for (const FClockSyncSample& Sample : Samples)
+	{
+		Variance += FMath::Square(Sample.RoundTripTime - MeanRoundTrip);
+	}
+	Jitter = FMath::Sqrt(Variance / Samples.Num());
+
+	// Weight samples by how close they are to the fastest round trip - queueing delay makes
+	// the half round trip assumption wrong, fast samples are the most trustworthy ones
+	const double WeightScale = FMath::Max(Jitter, MinJitterForWeighting);
+	double SumW = 0.0, SumX = 0.0, SumY = 0.0;
+	for (const FClockSyncSample& Sample : Samples)
+	{
+		const double W = 1.0 / (1.0 + FMath::Square((Sample.RoundTripTime - MinRoundTripTime) / WeightScale));
+		const double X = Sample.LocalTime - LatestLocalTime;
+		SumW += W;
+		SumX += W * X;
+		SumY += W * Sample.Offset;
+	}
+
+	const double MeanX = SumX / SumW;
+	const double MeanY = SumY / SumW;
+
+	// Weighted least squares fit of offset over time gives the drift
+	double FittedDrift = 0.0;
+	if (Samples.Num() >= MinSamplesForDrift && LatestLocalTime - OldestLocalTime >= MinDriftTimeSpan)
+	{
+		double SumXX = 0.0, SumXY = 0.0;
+		for (const FClockSyncSample& Sample : Samples)
+		{
+			const double W = 1.0 / (1.0 + FMath::Square((Sample.RoundTripTime - MinRoundTripTime) / WeightScale));
+			const double DX = (Sample.LocalTime - LatestLocalTime) - MeanX;
+			SumXX += W * DX * DX;
+			SumXY += W * DX * (Sample.Offset - MeanY);
+		}
+
+		if (SumXX > UE_DOUBLE_SMALL_NUMBER)
+		{
+			FittedDrift = FMath::Clamp(SumXY / SumXX, -Settings.MaxDrift, Settings.MaxDrift);
+		}
+	}
+
+	Drift = FittedDrift;
+	TargetReferenceTime = LatestLocalTime;
+	// Evaluate the fitted line at the newest sample
+	TargetOffset = MeanY - Drift * MeanX;
+	bHasEstimate = true;
+}
+
+void FServerClockEstimator::Advance(double LocalTime, double DeltaSeconds)
+{
+	if (!bHasEstimate)
+	{
+		return;
+	}
+
+	const double Target = GetTargetOffset(LocalTime);
+	const double Error = Target - AppliedOffset;
+
+	// First estimate or large error (e.g. hitch, server restart) - step directly
+	if (!bHasAppliedOffset || FMath::Abs(Error) > Settings.StepThreshold)
+	{
+		AppliedOffset = Target;
+		bHasAppliedOffset = true;
+		return;
+	}
+
+	// Slew to keep server time continuous and monotonic
+	const double MaxCorrection = Settings.MaxSlewRate * FMath::Max(DeltaSeconds, 0.0);
+	AppliedOffset += FMath::Clamp(Error, -MaxCorrection, MaxCorrection);
+}
+
+float FServerClockEstimator::GetNextSyncInterval() const
+{
+	// Sample fast until the filter has enough data
+	if (!IsConverged())
+	{
+		return Settings.MinSyncInterval;
+	}
+
+	// Noisy links need more samples to find a fast one, stable links barely need any
+	const double JitterAlpha = FMath::Clamp(Jitter / FMath::Max(Settings.HighJitter, UE_DOUBLE_SMALL_NUMBER), 0.0, 1.0);
+	return FMath::Lerp(Settings.MaxSyncInterval, Settings.MinSyncInterval, static_cast<float>(JitterAlpha));
+}
+
+void FServerClockEstimator::Reset()
+{
+	Samples.Reset();
+	NextSampleIndex = 0;
+	TargetOffset = 0.0;
+	TargetReferenceTime = 0.0;
+	Drift = 0.0;
+	AppliedOffset = 0.0;
+	Jitter = 0.0;
+	MinRoundTripTime = 0.0;
+	bHasEstimate = false;
+	bHasAppliedOffset = false;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Single time synchronization measurement.
+ */
+struct FClockSyncSample
+{
+	// Full round trip of the sync request
+	double RoundTripTime = 0.0;
+
+	// Estimated server - client offset at the moment the reply arrived
+	double Offset = 0.0;
+
+	// Client time when the reply arrived
+	double LocalTime = 0.0;
+};
+
+/**
+ * Filters time synchronization samples into a stable server clock estimate.
+ *
+ * Keeps a window of recent samples and weights them by round trip time, so a single delayed
+ * packet barely moves the estimate. The applied offset is slewed towards the filtered target
+ * instead of stepping, and a linear drift term is fitted over the sample window.
+ */
+class DODGER_API FServerClockEstimator
+{
+public:
+	struct FSettings
+	{
+		// Number of samples kept in the filter window
+		int32 MaxSamples = 16;
+
+		// Samples needed before the estimate is considered converged
+		int32 MinSamplesToConverge = 5;
+
+		// Maximum speed of offset correction (seconds of correction per second of client time)
+		double MaxSlewRate = 0.05;
+
+		// Errors larger than this are stepped instead of slewed
+		double StepThreshold = 0.25;
+
+		// Maximum absolute drift accepted from the fit (seconds per second)
+		double MaxDrift = 0.001;
+
+		// Sync interval range, picked based on measured jitter
+		float MinSyncInterval = 0.5f;
+		float MaxSyncInterval = 10.0f;
+
+		// Jitter at which the minimum sync interval is used
+		double HighJitter = 0.03;
+	};
+
+	FServerClockEstimator() = default;
+	explicit FServerClockEstimator(const FSettings& InSettings);
+
+	/**
+	 * Add a sync result.
+	 * @param ClientSendTime	Client time when the request was sent
+	 * @param ServerTime		Server time when the request was processed
+	 * @param ClientReceiveTime	Client time when the reply arrived
+	 */
+	void AddSample(double ClientSendTime, double ServerTime, double ClientReceiveTime);
+
+	/**
+	 * Move applied offset towards the filtered target. Call once per frame.
+	 */
+	void Advance(double LocalTime, double DeltaSeconds);
+
+	/**
+	 * Estimated server time for given client time.
+	 */
+	double GetServerTime(double LocalTime) const { return LocalTime + AppliedOffset; }
+
+	/**
+	 * Time until the next sync request should be sent.
+	 */
+	float GetNextSyncInterval() const;
+
+	bool HasEstimate() const { return bHasEstimate; }
+	bool IsConverged() const { return bHasEstimate && Samples.Num() >= Settings.MinSamplesToConverge; }
+	double GetJitter() const { return Jitter; }
+	double GetDrift() const { return Drift; }
+	double GetMinRoundTripTime() const { return MinRoundTripTime; }
+
+	void Reset();
+
+private:
+	void RefreshEstimate();
+	double GetTargetOffset(double LocalTime) const { return TargetOffset + Drift * (LocalTime - TargetReferenceTime); }
+
+	FSettings Settings;
+
+	// Ring buffer of recent samples
+	TArray<FClockSyncSample> Samples;
+	int32 NextSampleIndex = 0;
+
+	// Filtered estimate: offset at TargetReferenceTime plus drift
+	double TargetOffset = 0.0;
+	double TargetReferenceTime = 0.0;
+	double Drift = 0.0;
+
+	// Offset currently used to produce server time
+	double AppliedOffset = 0.0;
+
+	double Jitter = 0.0;
+	double MinRoundTripTime = 0.0;
+
+	bool bHasEstimate = false;
+	bool bHasAppliedOffset = false;
+};
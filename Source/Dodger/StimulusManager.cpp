@@ -0,0 +1,147 @@
+
+#include "StimulusManager.h"
+
+#include "Data/EnemyConfig.h"
+#include "DodgerStats.h"
+#include "DodgerStressTimings.h"
+
+namespace
+{
+	// Minimal 2D speed squared for a source to broadcast presence
+	constexpr float MinPresenceSpeedSquared = 1.0f;
+}
+
+UStimulusManager* UStimulusManager::Get(const UObject* WorldContext)
+{
+	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		return World->GetSubsystem<UStimulusManager>();
+	}
+
+	return nullptr;
+}
+
+bool UStimulusManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UStimulusManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UEnemyConfig* Config = GetDefault<UEnemyConfig>();
+	CellSize = FMath::Max(Config->StimulusCellSize, 1.0f);
+	NoiseLifetime = Config->NoiseLifetime;
+}
+
+void UStimulusManager::RegisterSource(AActor* Actor)
+{
+	if (Actor)
+	{
+		Sources.AddUnique(Actor);
+	}
+}
+
+void UStimulusManager::UnregisterSource(AActor* Actor)
+{
+	Sources.RemoveSingleSwap(Actor, EAllowShrinking::No);
+}
+
+void UStimulusManager::ReportNoise(const FVector& Location, AActor* Instigator)
+{
+	FNoiseEvent& Noise = Noises.AddDefaulted_GetRef();
+	Noise.Stimulus.Source = Instigator;
+	Noise.Stimulus.Location = Location;
+	Noise.Stimulus.Type = EDodgerStimulusType::Noise;
+	Noise.ExpireTime = GetWorld()->GetTimeSeconds() + NoiseLifetime;
+}
+
+void UStimulusManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DODGER_STRESS_TIMING_SCOPE("Stimuli");
+	LLM_SCOPE_BYTAG(Dodger_Perception);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	Sources.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Source) { return !Source.IsValid(); }, EAllowShrinking::No);
+	Noises.RemoveAllSwap([Now](const FNoiseEvent& Noise) { return Noise.ExpireTime <= Now; }, EAllowShrinking::No);
+
+	// Rebuild grid - keep cell arrays allocated, cells of a level are mostly the same frame to frame
+	FrameStimuli.Reset();
+	for (TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (const TWeakObjectPtr<AActor>& Source : Sources)
+	{
+		if (Source->GetVelocity().SizeSquared2D() > MinPresenceSpeedSquared)
+		{
+			FDodgerStimulus& Stimulus = FrameStimuli.AddDefaulted_GetRef();
+			Stimulus.Source = Source;
+			Stimulus.Location = Source->GetActorLocation();
+			Stimulus.Type = EDodgerStimulusType::Presence;
+		}
+	}
+
+	for (const FNoiseEvent& Noise : Noises)
+	{
+		FrameStimuli.Add(Noise.Stimulus);
+	}
+
+	for (int32 Index = 0; Index < FrameStimuli.Num(); ++Index)
+	{
+		Cells.FindOrAdd(GetCell(FrameStimuli[Index].Location)).Add(Index);
+	}
+}
+
+void UStimulusManager::QueryStimuli(const FVector& Location, float Radius, const AActor* IgnoredActor, TArray<FDodgerStimulus>& OutStimuli) const
+{
+	const FIntPoint MinCell = GetCell(Location - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Location + FVector(Radius));
+	const float RadiusSquared = FMath::Square(Radius);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (const int32 Index : *Cell)
+			{
+				const FDodgerStimulus& Stimulus = FrameStimuli[Index];
+				if (Stimulus.Source.Get() != IgnoredActor && FVector::DistSquared(Location, Stimulus.Location) <= RadiusSquared)
+				{
+					OutStimuli.Add(Stimulus);
+				}
+			}
+		}
+	}
+}
+
+FIntPoint UStimulusManager::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+SIZE_T UStimulusManager::GetAllocatedSize() const
+{
+	SIZE_T Size = Sources.GetAllocatedSize() + Noises.GetAllocatedSize() + FrameStimuli.GetAllocatedSize() + Cells.GetAllocatedSize();
+	for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+	{
+		Size += Cell.Value.GetAllocatedSize();
+	}
+	return Size;
+}
+
+TStatId UStimulusManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStimulusManager, STATGROUP_Tickables);
+}
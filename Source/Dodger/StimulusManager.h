@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StimulusManager.generated.h"
+
+enum class EDodgerStimulusType : uint8
+{
+	// Moving character
+	Presence,
+	// Noise event (e.g. projectile impact), Source is the instigator
+	Noise,
+};
+
+struct FDodgerStimulus
+{
+	TWeakObjectPtr<AActor> Source;
+	FVector Location = FVector::ZeroVector;
+	EDodgerStimulusType Type = EDodgerStimulusType::Presence;
+};
+
+/**
+ * Lightweight AI stimulus broadcast (server only).
+ * Moving characters and short lived noise events are hashed into a uniform 2D grid once per frame,
+ * enemies query only cells around them at their own update rate, so the cost per query does not
+ * grow with number of characters in the level.
+ */
+UCLASS()
+class DODGER_API UStimulusManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UStimulusManager* Get(const UObject* WorldContext);
+	/**
+	 *  Add/remove actor broadcasting its presence while moving
+	 */
+	void RegisterSource(AActor* Actor);
+	void UnregisterSource(AActor* Actor);
+	/**
+	 *  Broadcast noise at location, heard for UEnemyConfig::NoiseLifetime
+	 */
+	void ReportNoise(const FVector& Location, AActor* Instigator);
+	/**
+	 *  Gather stimuli within radius of location, ignoring stimuli of IgnoredActor
+	 */
+	void QueryStimuli(const FVector& Location, float Radius, const AActor* IgnoredActor, TArray<FDodgerStimulus>& OutStimuli) const;
+	/**
+	 *  Memory owned by sources, noises and the grid (see UDodgerMemoryTracker)
+	 */
+	SIZE_T GetAllocatedSize() const;
+	
+	// Base Interface Start
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// Base Interface End
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	
+private:
+	struct FNoiseEvent
+	{
+		FDodgerStimulus Stimulus;
+		double ExpireTime = 0.0;
+	};
+	
+	FIntPoint GetCell(const FVector& Location) const;
+	
+	TArray<TWeakObjectPtr<AActor>> Sources;
+	TArray<FNoiseEvent> Noises;
+	
+	// Stimuli of current frame and their grid cells (indices into FrameStimuli)
+	TArray<FDodgerStimulus> FrameStimuli;
+	TMap<FIntPoint, TArray<int32>> Cells;
+	
+	float CellSize = 1000.0f;
+	float NoiseLifetime = 1.0f;
+};
@@ -0,0 +1,54 @@
+
+#include "Dodger/CombatActionTimeline.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatActionTimelineChainedAttacksTest, "Dodger.Combat.ActionTimeline.ChainedAttacks",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatActionTimelineChainedAttacksTest::RunTest(const FString& Parameters)
+{
+	// Attack montage of 1 s with the default 0.25 s blend out, held fire chains at 0.75 s
+	constexpr float Duration = 1.0f;
+	constexpr float BlendOutTime = 0.25f;
+
+	FCombatActionTimeline Timeline;
+	TestTrue(TEXT("First attack is accepted"), Timeline.TryStart(10.0f, Duration, BlendOutTime));
+	TestTrue(TEXT("Attack chained at blend out is accepted"), Timeline.TryStart(10.75f, Duration, BlendOutTime));
+	TestTrue(TEXT("Attack chained slightly early (clock estimate error) is accepted"), Timeline.TryStart(11.48f, Duration, BlendOutTime));
+	TestFalse(TEXT("Attack before blend out is rejected"), Timeline.TryStart(11.8f, Duration, BlendOutTime));
+
+	Timeline.Reset();
+	TestTrue(TEXT("Attack after reset is accepted"), Timeline.TryStart(11.8f, Duration, BlendOutTime));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatActionTimelineEarlyCadenceTest, "Dodger.Combat.ActionTimeline.EarlyCadence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatActionTimelineEarlyCadenceTest::RunTest(const FString& Parameters)
+{
+	// Client stamping every chained attack as early as the tolerance allows (0.70 s instead of 0.75 s)
+	constexpr float Duration = 1.0f;
+	constexpr float BlendOutTime = 0.25f;
+	constexpr float Spacing = Duration - BlendOutTime - FCombatActionTimeline::Tolerance;
+
+	FCombatActionTimeline Timeline;
+	TestTrue(TEXT("First attack is accepted"), Timeline.TryStart(10.0f, Duration, BlendOutTime));
+	TestTrue(TEXT("One early attack is accepted"), Timeline.TryStart(10.0f + Spacing, Duration, BlendOutTime));
+	TestFalse(TEXT("Steady early cadence is rejected"), Timeline.TryStart(10.0f + 2.0f * Spacing, Duration, BlendOutTime));
+
+	int32 NumAccepted = 0;
+	for (int32 Index = 0; Index < 20; ++Index)
+	{
+		NumAccepted += Timeline.TryStart(20.0f + Index * Spacing, Duration, BlendOutTime) ? 1 : 0;
+	}
+	TestTrue(TEXT("Early cadence gets no more attacks than the real spacing allows"), NumAccepted <= FMath::FloorToInt32(19 * Spacing / (Duration - BlendOutTime)) + 1);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -11,5 +11,8 @@ public class DodgerEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
 		ExtraModuleNames.Add("Dodger");
+
+		// Iris replication compiled in (UE_WITH_IRIS), enabled at runtime with -UseIrisReplication=1
+		bUseIris = true;
 	}
 }
@@ -0,0 +1,18 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class DodgerServerTarget : TargetRules
+{
+	public DodgerServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
+		ExtraModuleNames.Add("Dodger");
+
+		// Iris replication compiled in (UE_WITH_IRIS), enabled at runtime with -UseIrisReplication=1
+		bUseIris = true;
+	}
+}